@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <climits>
+
+#if defined(__linux__)
+#define ATOMICBASE_FUTEX 1
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#elif defined(_WIN32)
+#define ATOMICBASE_WAIT_ON_ADDRESS 1
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+class AddressWait
+{
+
+public:
+
+    using duration_type = std::chrono::nanoseconds;
+
+    static constexpr duration_type Infinite = duration_type::max();
+
+    static void Wait(const std::atomic<std::uint32_t>& word, std::uint32_t old, duration_type timeout = Infinite)
+    {
+        if (word.load(std::memory_order_acquire) != old || timeout <= duration_type::zero())
+            return;
+
+#if defined(ATOMICBASE_FUTEX)
+        if (timeout == Infinite)
+        {
+            syscall(SYS_futex, Address(word), FUTEX_WAIT_PRIVATE, old, nullptr, nullptr, 0);
+            return;
+        }
+
+        auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+
+        timespec relative{};
+        relative.tv_sec = static_cast<time_t>(seconds.count());
+        relative.tv_nsec = static_cast<long>((timeout - seconds).count());
+
+        syscall(SYS_futex, Address(word), FUTEX_WAIT_PRIVATE, old, &relative, nullptr, 0);
+#elif defined(ATOMICBASE_WAIT_ON_ADDRESS)
+        DWORD milliseconds = INFINITE;
+
+        if (timeout != Infinite)
+        {
+            auto rounded = std::chrono::ceil<std::chrono::milliseconds>(timeout).count();
+            milliseconds = rounded >= INFINITE ? INFINITE - 1 : static_cast<DWORD>(rounded);
+        }
+
+        WaitOnAddress(const_cast<std::uint32_t*>(Address(word)), &old, sizeof(old), milliseconds);
+#else
+        Bucket& bucket = BucketOf(&word);
+        std::unique_lock<std::mutex> lock(bucket.mutex);
+
+        if (timeout == Infinite)
+            bucket.changed.wait(lock, [&word, old] { return word.load(std::memory_order_acquire) != old; });
+        else
+            bucket.changed.wait_for(lock, timeout, [&word, old] { return word.load(std::memory_order_acquire) != old; });
+#endif
+    }
+
+    static void WakeAll(std::atomic<std::uint32_t>& word)
+    {
+#if defined(ATOMICBASE_FUTEX)
+        syscall(SYS_futex, Address(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#elif defined(ATOMICBASE_WAIT_ON_ADDRESS)
+        WakeByAddressAll(const_cast<std::uint32_t*>(Address(word)));
+#else
+        Bucket& bucket = BucketOf(&word);
+
+        {
+            std::lock_guard<std::mutex> lock(bucket.mutex);
+        }
+
+        bucket.changed.notify_all();
+#endif
+    }
+
+private:
+
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "Address waits require a lock-free 32-bit atomic.");
+
+    static const std::uint32_t* Address(const std::atomic<std::uint32_t>& word)
+    {
+        return reinterpret_cast<const std::uint32_t*>(&word);
+    }
+
+#if !defined(ATOMICBASE_FUTEX) && !defined(ATOMICBASE_WAIT_ON_ADDRESS)
+    static constexpr size_t BucketCount = 64;
+
+    struct alignas(64) Bucket
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+    };
+
+    static Bucket& BucketOf(const void* address)
+    {
+        static Bucket buckets[BucketCount];
+        return buckets[(reinterpret_cast<std::uintptr_t>(address) >> 4) % BucketCount];
+    }
+#endif
+
+};
@@ -0,0 +1,885 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+#include "AtomicString.hpp"
+#include "LockPolicy.hpp"
+#include "CaseConversion.hpp"
+#include "ReplaceSet.hpp"
+#include "Searcher.hpp"
+
+template <typename T, typename LockPolicy = SharedMutexLockPolicy>
+class AtomicRope
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+    struct Node
+    {
+        explicit Node(std::basic_string<T>&& text, std::uint32_t priority) : data(std::move(text)), size(data.length()), length(data.length()), priority(priority) {}
+
+        mutable typename LockPolicy::mutex_type mutex;
+        std::basic_string<T> data;
+        std::atomic<size_t> size;
+        std::atomic<size_t> length;
+        std::uint32_t priority;
+        Node* parent = nullptr;
+        std::unique_ptr<Node> left;
+        std::unique_ptr<Node> right;
+    };
+
+    using node_pointer = std::unique_ptr<Node>;
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+    using mutex_type = typename LockPolicy::mutex_type;
+
+    static constexpr size_t ChunkSize = 4096;
+    static constexpr size_t MaxChunkSize = 2 * ChunkSize;
+    static constexpr size_t End = ~size_t(0);
+
+    class ChunkSequence
+    {
+
+    public:
+
+        class iterator
+        {
+
+        public:
+
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = T;
+
+            iterator() = default;
+
+            iterator(const ChunkSequence* sequence, size_t position) : sequence(sequence), position(position)
+            {
+                std::shared_lock<mutex_type> lock(sequence->rope->structureMutex);
+                std::shared_lock<mutex_type> lengthLock(sequence->rope->lengthMutex);
+                Seek();
+            }
+
+            // Characters are copied out under the chunk lock, since an in-chunk
+            // edit can reallocate the chunk behind any reference handed out.
+            T operator*() const
+            {
+                std::shared_lock<mutex_type> lock(sequence->rope->structureMutex);
+
+                while (true)
+                {
+                    Node* current;
+                    std::uint64_t seen;
+
+                    {
+                        std::shared_lock<mutex_type> lengthLock(sequence->rope->lengthMutex);
+                        Revalidate();
+
+                        current = node;
+                        seen = generation;
+                    }
+
+                    if (current == nullptr)
+                        throw std::runtime_error("Rope iterator is not dereferenceable.");
+
+                    std::shared_lock<mutex_type> chunkLock(current->mutex);
+
+                    if (sequence->rope->generation.load(std::memory_order_relaxed) == seen)
+                        return current->data[offset];
+                }
+            }
+
+            iterator& operator++()
+            {
+                std::shared_lock<mutex_type> lock(sequence->rope->structureMutex);
+                std::shared_lock<mutex_type> lengthLock(sequence->rope->lengthMutex);
+                Revalidate();
+
+                if (node != nullptr)
+                {
+                    ++offset;
+                    ++position;
+                    SkipEmpty();
+                }
+
+                return *this;
+            }
+
+            iterator& operator--()
+            {
+                std::shared_lock<mutex_type> lock(sequence->rope->structureMutex);
+                std::shared_lock<mutex_type> lengthLock(sequence->rope->lengthMutex);
+                Revalidate();
+
+                if (node == nullptr)
+                {
+                    position = Length(sequence->rope->root);
+                    node = Rightmost(sequence->rope->root.get());
+                    offset = node != nullptr ? node->size.load(std::memory_order_relaxed) : 0;
+                }
+
+                while (node != nullptr && offset == 0)
+                {
+                    node = Previous(node);
+                    offset = node != nullptr ? node->size.load(std::memory_order_relaxed) : 0;
+                }
+
+                if (node != nullptr)
+                {
+                    --offset;
+                    --position;
+                }
+
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const
+            {
+                std::shared_lock<mutex_type> lock(sequence->rope->structureMutex);
+                std::shared_lock<mutex_type> lengthLock(sequence->rope->lengthMutex);
+
+                Revalidate();
+                other.Revalidate();
+
+                return node == other.node && offset == other.offset;
+            }
+
+            bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            void Revalidate() const
+            {
+                if (generation != sequence->rope->generation.load(std::memory_order_relaxed))
+                    Seek();
+            }
+
+            void Seek() const
+            {
+                std::vector<Node*> path;
+
+                generation = sequence->rope->generation.load(std::memory_order_relaxed);
+                node = position < Length(sequence->rope->root) ? sequence->rope->Locate(position, false, path, offset) : nullptr;
+
+                if (node == nullptr)
+                    offset = 0;
+            }
+
+            void SkipEmpty()
+            {
+                while (node != nullptr && offset >= node->size.load(std::memory_order_relaxed))
+                {
+                    node = Next(node);
+                    offset = 0;
+                }
+            }
+
+            const ChunkSequence* sequence = nullptr;
+            size_t position = 0;
+            mutable std::uint64_t generation = 0;
+            mutable Node* node = nullptr;
+            mutable size_t offset = 0;
+
+        };
+
+        using const_iterator = iterator;
+
+        explicit ChunkSequence(AtomicRope* rope) : rope(rope) {}
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, End);
+        }
+
+    private:
+
+        AtomicRope* rope;
+
+    };
+
+    using iterator_type = ThreadSafeIterator<T, LockPolicy, ChunkSequence>;
+
+    AtomicRope() = default;
+    ~AtomicRope() = default;
+
+    AtomicRope(const AtomicRope& other) = delete;
+    AtomicRope& operator=(const AtomicRope& other) = delete;
+
+    AtomicRope(AtomicRope&& other) noexcept
+    {
+        std::unique_lock<mutex_type> lock(other.structureMutex);
+        root = std::move(other.root);
+        other.Restructured();
+    }
+
+    AtomicRope(view_type str) : root(Build(str)) {}
+
+    AtomicRope(const string_type& str) : AtomicRope(view_type(str)) {}
+
+    AtomicRope(const T* str) : AtomicRope(view_type(str)) {}
+
+    AtomicRope& operator=(AtomicRope&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::unique_lock<mutex_type> lockThis(structureMutex, std::defer_lock);
+            std::unique_lock<mutex_type> lockOther(other.structureMutex, std::defer_lock);
+            std::lock(lockThis, lockOther);
+
+            root = std::move(other.root);
+
+            Restructured();
+            other.Restructured();
+        }
+
+        return *this;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicRope& operator=(const U& input)
+    {
+        view_type value(input);
+
+        std::unique_lock<mutex_type> lock(structureMutex);
+        root = Build(value);
+        Restructured();
+
+        return *this;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator==(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](const string_type& data) { return data == value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator!=(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](const string_type& data) { return data != value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator<(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](const string_type& data) { return data < value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator<=(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](const string_type& data) { return data <= value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator>(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](const string_type& data) { return data > value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator>=(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](const string_type& data) { return data >= value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicRope& operator+=(const U& input)
+    {
+        Append(view_type(input));
+        return *this;
+    }
+
+    AtomicRope& operator+=(AtomicRope&& other)
+    {
+        Append(std::move(other));
+        return *this;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicRope& operator-=(const U& input)
+    {
+        view_type other(input);
+
+        if (other.empty())
+            return *this;
+
+        std::unique_lock<mutex_type> lock(structureMutex);
+
+        size_t position = Searcher<T>(other).Find(Flatten());
+
+        if (position != Searcher<T>::npos)
+            Replace(position, other.length(), view_type());
+
+        return *this;
+    }
+
+    void Insert(size_t position, view_type text)
+    {
+        if (text.empty() || EditChunk(position, 0, text, true))
+            return;
+
+        std::unique_lock<mutex_type> lock(structureMutex);
+
+        size_t length = Length(root);
+
+        if (position == End)
+            position = length;
+        else if (position > length)
+            throw std::runtime_error("Rope position out of range.");
+
+        Replace(position, 0, text);
+    }
+
+    void Erase(size_t position, size_t count = End)
+    {
+        if (count == 0 || (count != End && EditChunk(position, count, view_type(), false)))
+            return;
+
+        std::unique_lock<mutex_type> lock(structureMutex);
+
+        size_t length = Length(root);
+
+        if (position > length)
+            throw std::runtime_error("Rope position out of range.");
+
+        Replace(position, std::min(count, length - position), view_type());
+    }
+
+    void Append(view_type text)
+    {
+        Insert(End, text);
+    }
+
+    void Append(AtomicRope&& other)
+    {
+        if (this == &other)
+            return;
+
+        std::unique_lock<mutex_type> lockThis(structureMutex, std::defer_lock);
+        std::unique_lock<mutex_type> lockOther(other.structureMutex, std::defer_lock);
+        std::lock(lockThis, lockOther);
+
+        root = Merge(std::move(root), std::move(other.root));
+
+        if (root)
+            root->parent = nullptr;
+
+        Restructured();
+        other.Restructured();
+    }
+
+    void FindAndReplace(view_type find, view_type replace)
+    {
+        if (find.empty())
+            return;
+
+        Modify([find, replace](string_type& str) { ReplaceSet<T>::ReplaceAllIn(str, find, replace); });
+    }
+
+    void FindAndReplace(const ReplaceSet<T>& replacements)
+    {
+        Modify([&replacements](string_type& str) { replacements.ApplyTo(str); });
+    }
+
+    void ToUpper()
+    {
+        std::unique_lock<mutex_type> lock(structureMutex);
+        ForEachNode(root.get(), [](Node* node) { CaseConversion::ToUpper(node->data.data(), node->data.length()); });
+    }
+
+    void ToLower()
+    {
+        std::unique_lock<mutex_type> lock(structureMutex);
+        ForEachNode(root.get(), [](Node* node) { CaseConversion::ToLower(node->data.data(), node->data.length()); });
+    }
+
+    size_t Find(view_type needle, size_t from = 0) const
+    {
+        Searcher<T> searcher(needle);
+        return Read([&searcher, from](const string_type& str) { return searcher.Find(str, from); });
+    }
+
+    bool Contains(view_type needle) const
+    {
+        return Find(needle) != Searcher<T>::npos;
+    }
+
+    size_t Count(view_type needle) const
+    {
+        Searcher<T> searcher(needle);
+        return Read([&searcher](const string_type& str) { return searcher.Count(str); });
+    }
+
+    template <typename F>
+    auto Modify(F&& function)
+    {
+        std::unique_lock<mutex_type> lock(structureMutex);
+
+        string_type data = Flatten();
+
+        if constexpr (std::is_void_v<std::invoke_result_t<F&, string_type&>>)
+        {
+            function(data);
+            root = Build(data);
+            Restructured();
+        }
+        else
+        {
+            auto result = function(data);
+            root = Build(data);
+            Restructured();
+
+            return result;
+        }
+    }
+
+    template <typename F>
+    auto Read(F&& function) const
+    {
+        std::shared_lock<mutex_type> lock(structureMutex);
+
+        std::vector<const Node*> locked;
+        string_type data;
+
+        auto release = [&locked]
+        {
+            for (const Node* node : locked)
+                node->mutex.unlock_shared();
+        };
+
+        try
+        {
+            data.reserve(Length(root));
+
+            ForEachNode(root.get(), [&locked, &data](const Node* node)
+            {
+                node->mutex.lock_shared();
+                locked.push_back(node);
+                data.append(node->data);
+            });
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+
+        release();
+
+        return function(static_cast<const string_type&>(data));
+    }
+
+    // Iterators re-seek by position after concurrent edits and dereference to
+    // a copy of the character; write through Insert, Erase or Modify instead.
+    iterator_type begin()
+    {
+        return iterator_type::Begin(chunks, iteratorMutex);
+    }
+
+    iterator_type end()
+    {
+        return iterator_type::End(chunks, iteratorMutex);
+    }
+
+    size_t Length() const
+    {
+        std::shared_lock<mutex_type> lock(structureMutex);
+        return Length(root);
+    }
+
+    template <typename F>
+    void ForEachChunk(F&& function) const
+    {
+        std::shared_lock<mutex_type> lock(structureMutex);
+
+        std::vector<const Node*> locked;
+
+        auto release = [&locked]
+        {
+            for (const Node* node : locked)
+                node->mutex.unlock_shared();
+        };
+
+        try
+        {
+            ForEachNode(root.get(), [&locked, &function](const Node* node)
+            {
+                node->mutex.lock_shared();
+                locked.push_back(node);
+
+                if (!node->data.empty())
+                    function(view_type(node->data));
+            });
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+
+        release();
+    }
+
+    size_t ChunkCount() const
+    {
+        std::shared_lock<mutex_type> lock(structureMutex);
+
+        size_t count = 0;
+        ForEachNode(root.get(), [&count](const Node*) { ++count; });
+
+        return count;
+    }
+
+    void Clear()
+    {
+        std::unique_lock<mutex_type> lock(structureMutex);
+        root.reset();
+        Restructured();
+    }
+
+    operator string_type() const
+    {
+        return Read([](const string_type& str) { return str; });
+    }
+
+private:
+
+    void Restructured()
+    {
+        generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static size_t Length(const node_pointer& node)
+    {
+        return node ? node->length.load(std::memory_order_relaxed) : 0;
+    }
+
+    static Node* Leftmost(Node* node)
+    {
+        while (node != nullptr && node->left)
+            node = node->left.get();
+
+        return node;
+    }
+
+    static Node* Rightmost(Node* node)
+    {
+        while (node != nullptr && node->right)
+            node = node->right.get();
+
+        return node;
+    }
+
+    static Node* Next(Node* node)
+    {
+        if (node->right)
+            return Leftmost(node->right.get());
+
+        while (node->parent != nullptr && node->parent->right.get() == node)
+            node = node->parent;
+
+        return node->parent;
+    }
+
+    static Node* Previous(Node* node)
+    {
+        if (node->left)
+            return Rightmost(node->left.get());
+
+        while (node->parent != nullptr && node->parent->left.get() == node)
+            node = node->parent;
+
+        return node->parent;
+    }
+
+    template <typename N, typename F>
+    static void ForEachNode(N* node, F&& function)
+    {
+        std::vector<N*> stack;
+
+        while (node != nullptr || !stack.empty())
+        {
+            while (node != nullptr)
+            {
+                stack.push_back(node);
+                node = node->left.get();
+            }
+
+            node = stack.back();
+            stack.pop_back();
+
+            function(node);
+
+            node = node->right.get();
+        }
+    }
+
+    static void Update(Node* node)
+    {
+        if (node->left)
+            node->left->parent = node;
+
+        if (node->right)
+            node->right->parent = node;
+
+        node->size.store(node->data.length(), std::memory_order_relaxed);
+        node->length.store(Length(node->left) + node->data.length() + Length(node->right), std::memory_order_relaxed);
+    }
+
+    node_pointer MakeNode(string_type&& text)
+    {
+        return std::make_unique<Node>(std::move(text), static_cast<std::uint32_t>(random()));
+    }
+
+    node_pointer Build(view_type text)
+    {
+        node_pointer result;
+
+        for (size_t i = 0; i < text.length(); i += ChunkSize)
+            result = Merge(std::move(result), MakeNode(string_type(text.substr(i, ChunkSize))));
+
+        if (result)
+            result->parent = nullptr;
+
+        return result;
+    }
+
+    static node_pointer Merge(node_pointer left, node_pointer right)
+    {
+        if (!left)
+            return right;
+
+        if (!right)
+            return left;
+
+        if (left->priority > right->priority)
+        {
+            left->right = Merge(std::move(left->right), std::move(right));
+            Update(left.get());
+
+            return left;
+        }
+
+        right->left = Merge(std::move(left), std::move(right->left));
+        Update(right.get());
+
+        return right;
+    }
+
+    void Split(node_pointer node, size_t position, node_pointer& left, node_pointer& right)
+    {
+        if (!node)
+        {
+            left.reset();
+            right.reset();
+
+            return;
+        }
+
+        size_t leftLength = Length(node->left);
+        size_t size = node->data.length();
+
+        if (position <= leftLength)
+        {
+            Split(std::move(node->left), position, left, node->left);
+            Update(node.get());
+            right = std::move(node);
+        }
+        else if (position >= leftLength + size)
+        {
+            Split(std::move(node->right), position - leftLength - size, node->right, right);
+            Update(node.get());
+            left = std::move(node);
+        }
+        else
+        {
+            size_t offset = position - leftLength;
+
+            right = Merge(MakeNode(node->data.substr(offset)), std::move(node->right));
+            node->data.resize(offset);
+            Update(node.get());
+            left = std::move(node);
+        }
+
+        if (left)
+            left->parent = nullptr;
+
+        if (right)
+            right->parent = nullptr;
+    }
+
+    void Replace(size_t position, size_t count, view_type text)
+    {
+        node_pointer head, middle, tail;
+
+        Split(std::move(root), position, head, tail);
+        Split(std::move(tail), count, middle, tail);
+
+        root = Merge(Merge(std::move(head), Build(text)), std::move(tail));
+
+        if (root)
+            root->parent = nullptr;
+
+        Restructured();
+    }
+
+    string_type Flatten() const
+    {
+        string_type data;
+
+        data.reserve(Length(root));
+        ForEachNode(root.get(), [&data](const Node* node) { data.append(node->data); });
+
+        return data;
+    }
+
+    Node* Locate(size_t position, bool insert, std::vector<Node*>& path, size_t& offset) const
+    {
+        Node* node = root.get();
+
+        path.clear();
+
+        while (node != nullptr)
+        {
+            path.push_back(node);
+
+            size_t left = node->left ? node->left->length.load(std::memory_order_relaxed) : 0;
+            size_t size = node->size.load(std::memory_order_relaxed);
+
+            if (position == End)
+            {
+                if (!node->right)
+                {
+                    offset = size;
+                    return node;
+                }
+
+                node = node->right.get();
+                continue;
+            }
+
+            if (node->left && (insert ? position <= left : position < left))
+            {
+                node = node->left.get();
+                continue;
+            }
+
+            if (insert ? position <= left + size : position < left + size)
+            {
+                offset = position - left;
+                return node;
+            }
+
+            position -= left + size;
+            node = node->right.get();
+        }
+
+        return nullptr;
+    }
+
+    // Chunk edits share structureMutex, so the tree shape is fixed, but chunk
+    // sizes and subtree lengths move. lengthMutex makes each edit's size and
+    // ancestor updates one step for Locate, which would otherwise see a
+    // half-applied fetch_add walk and map a position into the wrong chunk.
+    Node* LocateConsistent(size_t position, bool insert, std::vector<Node*>& path, size_t& offset) const
+    {
+        std::shared_lock<mutex_type> lengthLock(lengthMutex);
+        return Locate(position, insert, path, offset);
+    }
+
+    bool EditChunk(size_t position, size_t count, view_type text, bool insert)
+    {
+        std::shared_lock<mutex_type> lock(structureMutex);
+
+        std::vector<Node*> path;
+        size_t offset;
+
+        path.reserve(64);
+
+        Node* node = LocateConsistent(position, insert, path, offset);
+
+        while (node != nullptr)
+        {
+            std::unique_lock<mutex_type> chunkLock(node->mutex);
+
+            Node* current = LocateConsistent(position, insert, path, offset);
+
+            if (current != node)
+            {
+                node = current;
+                continue;
+            }
+
+            if (count > node->data.length() - offset || node->data.length() - count + text.length() > MaxChunkSize)
+                return false;
+
+            node->data.replace(offset, count, text);
+
+            std::unique_lock<mutex_type> lengthLock(lengthMutex);
+
+            node->size.store(node->data.length(), std::memory_order_relaxed);
+
+            size_t delta = text.length() - count;
+
+            for (Node* ancestor : path)
+                ancestor->length.fetch_add(delta, std::memory_order_relaxed);
+
+            Restructured();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    template <typename U, typename P>
+    friend std::basic_ostream<U>& operator<<(std::basic_ostream<U>& stream, const AtomicRope<U, P>& str);
+
+    mutable mutex_type structureMutex;
+    mutable mutex_type lengthMutex;
+    std::atomic<std::uint64_t> generation = 0;
+    std::minstd_rand random{ std::random_device{}() };
+    node_pointer root;
+    ChunkSequence chunks{ this };
+    typename iterator_type::lock_pointer_type iteratorMutex = std::make_shared<typename iterator_type::lock_type>();
+
+};
+
+template <typename T, typename LockPolicy>
+std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicRope<T, LockPolicy>& str)
+{
+    str.Read([&stream](const std::basic_string<T>& data) { stream << data; });
+    return stream;
+}
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include "AtomicString.hpp"
+#include "CaseConversion.hpp"
+#include "ReplaceSet.hpp"
+#include "Searcher.hpp"
+
+template <typename T, size_t InlineBytes = 48, typename LockPolicy = SharedMutexLockPolicy>
+class alignas(64) AtomicSmallString
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+    static constexpr size_t WordCount = (InlineBytes + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+    using overflow_type = AtomicString<T, LockPolicy>;
+
+    static constexpr size_t InlineCapacity = WordCount * sizeof(std::uint64_t) / sizeof(T);
+
+    AtomicSmallString() = default;
+
+    ~AtomicSmallString()
+    {
+        delete overflow.load(std::memory_order_relaxed);
+    }
+
+    AtomicSmallString(const AtomicSmallString& other) = delete;
+    AtomicSmallString& operator=(const AtomicSmallString& other) = delete;
+
+    AtomicSmallString(AtomicSmallString&& other) noexcept
+    {
+        std::uint32_t otherSequence = other.LockSequence();
+
+        for (size_t i = 0; i < WordCount; ++i)
+            words[i].store(other.words[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+        length.store(other.length.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        overflow.store(other.overflow.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        other.UnlockSequence(otherSequence);
+    }
+
+    AtomicSmallString(view_type str)
+    {
+        Store(str);
+    }
+
+    AtomicSmallString(const string_type& str) : AtomicSmallString(view_type(str)) {}
+
+    AtomicSmallString(const T* str) : AtomicSmallString(view_type(str)) {}
+
+    AtomicSmallString& operator=(AtomicSmallString&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        AtomicSmallString& first = std::less<AtomicSmallString*>{}(this, &other) ? *this : other;
+        AtomicSmallString& second = &first == this ? other : *this;
+
+        std::uint32_t firstSequence = first.LockSequence();
+        std::uint32_t secondSequence = second.LockSequence();
+
+        for (size_t i = 0; i < WordCount; ++i)
+            words[i].store(other.words[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        length.store(other.length.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        overflow_type* previous = overflow.exchange(other.overflow.exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+
+        second.UnlockSequence(secondSequence);
+        first.UnlockSequence(firstSequence);
+
+        delete previous;
+
+        return *this;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSmallString& operator=(const U& input)
+    {
+        view_type value(input);
+
+        if (overflow_type* heap = Update([value](string_type& data) { data.assign(value); }))
+            *heap = string_type(value);
+
+        return *this;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator==(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return data == value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator!=(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return data != value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator<(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return data < value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator<=(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return data <= value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator>(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return data > value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator>=(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return data >= value; });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSmallString& operator+=(const U& input)
+    {
+        view_type other(input);
+
+        if (overflow_type* heap = Update([other](string_type& data) { data.append(other); }))
+            *heap += string_type(other);
+
+        return *this;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSmallString& operator-=(const U& input)
+    {
+        view_type other(input);
+
+        overflow_type* heap = Update([other](string_type& data)
+        {
+            size_t position = Searcher<T>(other).Find(data);
+
+            if (position != string_type::npos)
+                data.erase(position, other.length());
+        });
+
+        if (heap != nullptr)
+            *heap -= string_type(other);
+
+        return *this;
+    }
+
+    void FindAndReplace(view_type find, view_type replace)
+    {
+        if (find.empty())
+            return;
+
+        if (overflow_type* heap = Update([find, replace](string_type& data) { ReplaceSet<T>::ReplaceAllIn(data, find, replace); }))
+            heap->FindAndReplace(string_type(find), string_type(replace));
+    }
+
+    void FindAndReplace(const ReplaceSet<T>& replacements)
+    {
+        if (overflow_type* heap = Update([&replacements](string_type& data) { replacements.ApplyTo(data); }))
+            heap->FindAndReplace(replacements);
+    }
+
+    void ToUpper()
+    {
+        if (overflow_type* heap = Update([](string_type& data) { CaseConversion::ToUpper(data.data(), data.length()); }))
+            heap->ToUpper();
+    }
+
+    void ToLower()
+    {
+        if (overflow_type* heap = Update([](string_type& data) { CaseConversion::ToLower(data.data(), data.length()); }))
+            heap->ToLower();
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool EqualsIgnoreCase(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return CaseConversion::EqualsIgnoreCase(data, value); });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    int CompareIgnoreCase(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return CaseConversion::CompareIgnoreCase(data, value); });
+    }
+
+    size_t Length() const
+    {
+        if (const overflow_type* heap = overflow.load(std::memory_order_acquire))
+            return heap->Length();
+
+        return Read([](view_type data) { return data.length(); });
+    }
+
+    void Clear()
+    {
+        if (overflow_type* heap = Update([](string_type& data) { data.clear(); }))
+            heap->Clear();
+    }
+
+    bool IsInline() const
+    {
+        return overflow.load(std::memory_order_acquire) == nullptr;
+    }
+
+    operator string_type() const
+    {
+        return Read([](view_type data) { return string_type(data); });
+    }
+
+    template <typename F>
+    void Modify(F&& function)
+    {
+        if (overflow_type* heap = Update(function))
+            heap->Modify(function);
+    }
+
+    template <typename F>
+    auto Read(F&& function) const
+    {
+        while (true)
+        {
+            std::uint32_t begin = sequence.load(std::memory_order_acquire);
+
+            if ((begin & 1) != 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            if (const overflow_type* heap = overflow.load(std::memory_order_acquire))
+                return heap->Read([&function](const string_type& str) { return function(view_type(str)); });
+
+            std::uint64_t copy[WordCount];
+
+            for (size_t i = 0; i < WordCount; ++i)
+                copy[i] = words[i].load(std::memory_order_relaxed);
+
+            size_t size = length.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) != begin)
+                continue;
+
+            T characters[InlineCapacity];
+            std::memcpy(characters, copy, sizeof(characters));
+
+            return function(view_type(characters, size));
+        }
+    }
+
+private:
+
+    std::uint32_t LockSequence()
+    {
+        std::uint32_t current = sequence.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            if ((current & 1) == 0 && sequence.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+
+            std::this_thread::yield();
+            current = sequence.load(std::memory_order_relaxed);
+        }
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        return current;
+    }
+
+    void UnlockSequence(std::uint32_t locked)
+    {
+        sequence.store(locked + 2, std::memory_order_release);
+    }
+
+    void Store(view_type value)
+    {
+        std::uint32_t locked = LockSequence();
+
+        if (value.length() <= InlineCapacity)
+            StoreInline(value);
+        else
+            overflow.store(new overflow_type(string_type(value)), std::memory_order_release);
+
+        UnlockSequence(locked);
+    }
+
+    void StoreInline(view_type value)
+    {
+        std::uint64_t copy[WordCount] = {};
+        std::memcpy(copy, value.data(), value.length() * sizeof(T));
+
+        for (size_t i = 0; i < WordCount; ++i)
+            words[i].store(copy[i], std::memory_order_relaxed);
+
+        length.store(static_cast<std::uint32_t>(value.length()), std::memory_order_relaxed);
+    }
+
+    template <typename F>
+    overflow_type* Update(F&& function)
+    {
+        if (overflow_type* heap = overflow.load(std::memory_order_acquire))
+            return heap;
+
+        std::uint32_t locked = LockSequence();
+
+        if (overflow_type* heap = overflow.load(std::memory_order_relaxed))
+        {
+            UnlockSequence(locked);
+            return heap;
+        }
+
+        std::uint64_t copy[WordCount];
+
+        for (size_t i = 0; i < WordCount; ++i)
+            copy[i] = words[i].load(std::memory_order_relaxed);
+
+        T characters[InlineCapacity];
+        std::memcpy(characters, copy, sizeof(characters));
+
+        string_type data(characters, length.load(std::memory_order_relaxed));
+
+        function(data);
+
+        if (data.length() <= InlineCapacity)
+            StoreInline(data);
+        else
+            overflow.store(new overflow_type(std::move(data)), std::memory_order_release);
+
+        UnlockSequence(locked);
+
+        return nullptr;
+    }
+
+    template <typename U, size_t B, typename P>
+    friend std::basic_ostream<U>& operator<<(std::basic_ostream<U>& stream, const AtomicSmallString<U, B, P>& str);
+
+    mutable std::atomic<std::uint32_t> sequence = 0;
+    std::atomic<std::uint32_t> length = 0;
+    std::atomic<std::uint64_t> words[WordCount] = {};
+    std::atomic<overflow_type*> overflow = nullptr;
+
+};
+
+template <typename T, size_t InlineBytes, typename LockPolicy>
+std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicSmallString<T, InlineBytes, LockPolicy>& str)
+{
+    if (str.IsInline())
+        str.Read([&stream](std::basic_string_view<T> data) { stream << data; });
+    else
+        stream << *str.overflow.load(std::memory_order_acquire);
+
+    return stream;
+}
+
+static_assert(sizeof(AtomicSmallString<char>) == 64, "AtomicSmallString<char> must occupy exactly one cache line.");
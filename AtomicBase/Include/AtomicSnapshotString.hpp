@@ -0,0 +1,493 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+#include <utility>
+#include "HazardPointer.hpp"
+#include "AtomicString.hpp"
+#include "CaseConversion.hpp"
+#include "ReplaceSet.hpp"
+#include "Searcher.hpp"
+
+template <typename T>
+class AtomicSnapshotString
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+    struct Buffer
+    {
+        explicit Buffer(std::basic_string<T>&& value) : data(std::move(value)) {}
+
+        std::atomic<size_t> references = 1;
+        const std::basic_string<T> data;
+    };
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+
+    class Snapshot
+    {
+
+    public:
+
+        Snapshot() = default;
+
+        Snapshot(const Snapshot& other) : buffer(other.buffer)
+        {
+            if (buffer != nullptr)
+                buffer->references.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Snapshot(Snapshot&& other) noexcept : buffer(std::exchange(other.buffer, nullptr)) {}
+
+        ~Snapshot()
+        {
+            Release(buffer);
+        }
+
+        Snapshot& operator=(Snapshot other) noexcept
+        {
+            std::swap(buffer, other.buffer);
+            return *this;
+        }
+
+        view_type View() const
+        {
+            return buffer != nullptr ? view_type(buffer->data) : view_type();
+        }
+
+        operator view_type() const
+        {
+            return View();
+        }
+
+        size_t Length() const
+        {
+            return View().length();
+        }
+
+    private:
+
+        friend class AtomicSnapshotString;
+
+        explicit Snapshot(Buffer* buffer) : buffer(buffer) {}
+
+        Buffer* Detach()
+        {
+            return std::exchange(buffer, nullptr);
+        }
+
+        Buffer* buffer = nullptr;
+
+    };
+
+    AtomicSnapshotString() = default;
+
+    ~AtomicSnapshotString()
+    {
+        Release(current.load(std::memory_order_relaxed));
+    }
+
+    AtomicSnapshotString(const AtomicSnapshotString& other) : current(other.Load().Detach()) {}
+
+    AtomicSnapshotString(AtomicSnapshotString&& other) noexcept
+    {
+        std::lock_guard<std::mutex> lock(other.writerMutex);
+        current.store(other.current.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_relaxed);
+    }
+
+    AtomicSnapshotString(string_type str) : current(Allocate(std::move(str))) {}
+
+    AtomicSnapshotString(view_type str) : current(Allocate(string_type(str))) {}
+
+    AtomicSnapshotString(const T* str) : current(Allocate(string_type(str))) {}
+
+    template <typename P, typename A>
+    AtomicSnapshotString(const AtomicString<T, P, A>& str) : current(Allocate(str.operator string_type())) {}
+
+    AtomicSnapshotString& operator=(const AtomicSnapshotString& other)
+    {
+        if (this != &other)
+        {
+            Snapshot snapshot = other.Load();
+
+            std::lock_guard<std::mutex> lock(writerMutex);
+            Publish(snapshot.Detach());
+        }
+
+        return *this;
+    }
+
+    AtomicSnapshotString& operator=(AtomicSnapshotString&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::scoped_lock lock(writerMutex, other.writerMutex);
+            Publish(other.current.exchange(nullptr, std::memory_order_acq_rel));
+        }
+
+        return *this;
+    }
+
+    AtomicSnapshotString& operator=(string_type input)
+    {
+        Store(std::move(input));
+        return *this;
+    }
+
+    AtomicSnapshotString& operator=(view_type input)
+    {
+        Store(string_type(input));
+        return *this;
+    }
+
+    AtomicSnapshotString& operator=(const T* input)
+    {
+        Store(string_type(input));
+        return *this;
+    }
+
+    Snapshot Load() const
+    {
+        HazardGuard guard;
+
+        while (true)
+        {
+            Buffer* buffer = guard.Protect(current);
+
+            if (buffer == nullptr)
+                return Snapshot();
+
+            size_t references = buffer->references.load(std::memory_order_relaxed);
+
+            while (references != 0)
+            {
+                if (buffer->references.compare_exchange_weak(references, references + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                    return Snapshot(buffer);
+            }
+        }
+    }
+
+    void Store(string_type value)
+    {
+        Buffer* buffer = Allocate(std::move(value));
+
+        std::lock_guard<std::mutex> lock(writerMutex);
+        Publish(buffer);
+    }
+
+    bool operator==(const AtomicSnapshotString& other) const
+    {
+        return Compare(other) == 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator==(const U& other) const
+    {
+        return Compare(view_type(other)) == 0;
+    }
+
+    bool operator!=(const AtomicSnapshotString& other) const
+    {
+        return Compare(other) != 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator!=(const U& other) const
+    {
+        return Compare(view_type(other)) != 0;
+    }
+
+    bool operator<(const AtomicSnapshotString& other) const
+    {
+        return Compare(other) < 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator<(const U& other) const
+    {
+        return Compare(view_type(other)) < 0;
+    }
+
+    bool operator<=(const AtomicSnapshotString& other) const
+    {
+        return Compare(other) <= 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator<=(const U& other) const
+    {
+        return Compare(view_type(other)) <= 0;
+    }
+
+    bool operator>(const AtomicSnapshotString& other) const
+    {
+        return Compare(other) > 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator>(const U& other) const
+    {
+        return Compare(view_type(other)) > 0;
+    }
+
+    bool operator>=(const AtomicSnapshotString& other) const
+    {
+        return Compare(other) >= 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool operator>=(const U& other) const
+    {
+        return Compare(view_type(other)) >= 0;
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSnapshotString operator+(const U& input) const
+    {
+        view_type other(input);
+
+        return AtomicSnapshotString(Read([other](view_type data)
+        {
+            string_type result;
+
+            result.reserve(data.length() + other.length());
+            result.append(data).append(other);
+
+            return result;
+        }));
+    }
+
+    AtomicSnapshotString operator+(const AtomicSnapshotString& other) const
+    {
+        Snapshot snapshot = other.Load();
+        return *this + snapshot.View();
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSnapshotString& operator+=(const U& input)
+    {
+        view_type other(input);
+
+        Update([other](const string_type& data)
+        {
+            string_type result;
+
+            result.reserve(data.length() + other.length());
+            result.append(data).append(other);
+
+            return result;
+        });
+
+        return *this;
+    }
+
+    AtomicSnapshotString& operator+=(const AtomicSnapshotString& other)
+    {
+        Snapshot snapshot = other.Load();
+        return *this += snapshot.View();
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSnapshotString operator-(const U& input) const
+    {
+        view_type other(input);
+
+        return AtomicSnapshotString(Read([other](view_type data)
+        {
+            string_type result(data);
+
+            size_t position = Searcher<T>(other).Find(result);
+
+            if (position != string_type::npos)
+                result.erase(position, other.length());
+
+            return result;
+        }));
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    AtomicSnapshotString& operator-=(const U& input)
+    {
+        view_type other(input);
+
+        Update([other](const string_type& data)
+        {
+            string_type result(data);
+
+            size_t position = Searcher<T>(other).Find(result);
+
+            if (position != string_type::npos)
+                result.erase(position, other.length());
+
+            return result;
+        });
+
+        return *this;
+    }
+
+    AtomicSnapshotString operator-(const AtomicSnapshotString& other) const
+    {
+        Snapshot snapshot = other.Load();
+        return *this - snapshot.View();
+    }
+
+    AtomicSnapshotString& operator-=(const AtomicSnapshotString& other)
+    {
+        Snapshot snapshot = other.Load();
+        return *this -= snapshot.View();
+    }
+
+    void FindAndReplace(view_type find, view_type replace)
+    {
+        if (find.empty())
+            return;
+
+        Update([find, replace](const string_type& data) { return ReplaceSet<T>::ReplaceAll(data, find, replace); });
+    }
+
+    void FindAndReplace(const ReplaceSet<T>& replacements)
+    {
+        Update([&replacements](const string_type& data) { return replacements.Apply(data); });
+    }
+
+    void ToUpper()
+    {
+        Update([](const string_type& data)
+        {
+            string_type result(data);
+            CaseConversion::ToUpper(result.data(), result.length());
+            return result;
+        });
+    }
+
+    void ToLower()
+    {
+        Update([](const string_type& data)
+        {
+            string_type result(data);
+            CaseConversion::ToLower(result.data(), result.length());
+            return result;
+        });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    bool EqualsIgnoreCase(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return CaseConversion::EqualsIgnoreCase(data, value); });
+    }
+
+    template <typename U> requires std::is_convertible_v<const U&, view_type>
+    int CompareIgnoreCase(const U& other) const
+    {
+        view_type value(other);
+        return Read([value](view_type data) { return CaseConversion::CompareIgnoreCase(data, value); });
+    }
+
+    template <typename F>
+    decltype(auto) Read(F&& function) const
+    {
+        HazardGuard guard;
+        const Buffer* buffer = guard.Protect(current);
+
+        return std::forward<F>(function)(buffer != nullptr ? view_type(buffer->data) : view_type());
+    }
+
+    template <typename F>
+    void Modify(F&& function)
+    {
+        Update([&function](const string_type& data)
+        {
+            string_type result(data);
+            function(result);
+            return result;
+        });
+    }
+
+    size_t Length() const
+    {
+        return Read([](view_type data) { return data.length(); });
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        Publish(nullptr);
+    }
+
+    operator string_type() const
+    {
+        return Read([](view_type data) { return string_type(data); });
+    }
+
+private:
+
+    static Buffer* Allocate(string_type&& value)
+    {
+        return new Buffer(std::move(value));
+    }
+
+    static void Release(Buffer* buffer)
+    {
+        if (buffer != nullptr && buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            HazardDomain::Retire(buffer);
+    }
+
+    template <typename F>
+    void Update(F&& function)
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+
+        const Buffer* buffer = current.load(std::memory_order_acquire);
+        static const string_type empty;
+
+        Publish(Allocate(function(buffer != nullptr ? buffer->data : empty)));
+    }
+
+    void Publish(Buffer* buffer)
+    {
+        Release(current.exchange(buffer, std::memory_order_acq_rel));
+    }
+
+    int Compare(view_type other) const
+    {
+        return Read([other](view_type data) { return data.compare(other); });
+    }
+
+    int Compare(const AtomicSnapshotString& other) const
+    {
+        if (this == &other)
+            return 0;
+
+        return other.Read([this](view_type otherData) { return Compare(otherData); });
+    }
+
+    template <typename U>
+    friend std::basic_ostream<U>& operator<<(std::basic_ostream<U>& stream, const AtomicSnapshotString<U>& str);
+
+    std::atomic<Buffer*> current = nullptr;
+    std::mutex writerMutex;
+
+};
+
+template <typename T>
+std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicSnapshotString<T>& str)
+{
+    typename AtomicSnapshotString<T>::Snapshot snapshot = str.Load();
+
+    stream << snapshot.View();
+
+    return stream;
+}
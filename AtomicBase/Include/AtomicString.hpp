@@ -1,32 +1,58 @@
+#pragma once
+
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <vector>
+#include <span>
+#include <thread>
+#include <stop_token>
+#include <coroutine>
+#include <chrono>
 #include <algorithm>
+#include <iterator>
 #include <iostream>
 #include <type_traits>
+#include <stdexcept>
 #include <cassert>
-#include <format>
-
-template <typename T>
+#include <cstdint>
+#include "LockPolicy.hpp"
+#include "CaseConversion.hpp"
+#include "Transcoder.hpp"
+#include "ReplaceSet.hpp"
+#include "Searcher.hpp"
+#include "ParallelTransform.hpp"
+#include "StringResource.hpp"
+#include "AddressWait.hpp"
+#include "FileIO.hpp"
+#include "EditJournal.hpp"
+#include "Instrumentation.hpp"
+
+template <typename T, typename LockPolicy = SharedMutexLockPolicy, typename Container = std::basic_string<T>>
 class ThreadSafeIterator
 {
 
 public:
 
     using string_type = std::basic_string<T>;
-    using iterator_type = typename string_type::iterator;
-    using const_iterator_type = typename string_type::const_iterator;
-    using lock_pointer_type = std::shared_ptr<std::mutex>;
+    using container_type = Container;
+    using iterator_type = typename container_type::iterator;
+    using const_iterator_type = typename container_type::const_iterator;
+    using lock_type = typename LockPolicy::iterator_mutex_type;
+    using lock_pointer_type = std::shared_ptr<lock_type>;
     using iterator_category = std::bidirectional_iterator_tag;
     using value_type = T;
     using difference_type = std::ptrdiff_t;
-    using pointer = T*;
-    using reference = T&;
+    using pointer = typename std::iterator_traits<iterator_type>::pointer;
+    using reference = typename std::iterator_traits<iterator_type>::reference;
+    using const_reference = std::conditional_t<std::is_reference_v<reference>, const T&, T>;
 
-    ThreadSafeIterator(string_type& str, lock_pointer_type lock) : data(&str), iterator(data->begin()), lock(std::move(lock)) {}
+    ThreadSafeIterator(container_type& str, lock_pointer_type lock) : data(&str), iterator(data->begin()), lock(std::move(lock)) {}
 
-    ThreadSafeIterator(string_type& str, lock_pointer_type lock, bool end) : data(&str), iterator(end ? data->end() : data->begin()), lock(std::move(lock)) {}
+    ThreadSafeIterator(container_type& str, lock_pointer_type lock, bool end) : data(&str), iterator(end ? data->end() : data->begin()), lock(std::move(lock)) {}
 
     ThreadSafeIterator(const ThreadSafeIterator& other) : data(other.data), iterator(other.iterator), lock(other.lock) {}
 
@@ -36,8 +62,14 @@ public:
     {
         if (this != &other) 
         {
-            std::lock_guard<std::mutex> lockOther(*other.lock);
-            std::lock_guard<std::mutex> lockThis(*lock);
+            std::unique_lock<lock_type> lockOther(*other.lock, std::defer_lock);
+            std::unique_lock<lock_type> lockThis(*lock, std::defer_lock);
+
+            if (other.lock.get() == lock.get())
+                lockThis.lock();
+            else
+                std::lock(lockOther, lockThis);
+
             data = other.data;
             iterator = other.iterator;
             lock = other.lock;
@@ -50,7 +82,7 @@ public:
     {
         if (this != &other) 
         {
-            std::lock_guard<std::mutex> lockThis(*lock);
+            std::lock_guard<lock_type> lockThis(*lock);
             data = other.data;
             iterator = std::move(other.iterator);
             lock = std::move(other.lock);
@@ -61,7 +93,7 @@ public:
 
     ThreadSafeIterator& operator++()
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
 
         if (iterator != data->end())
             ++iterator;
@@ -71,7 +103,7 @@ public:
 
     ThreadSafeIterator operator++(int)
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
 
         ThreadSafeIterator temp = *this;
         ++(*this);
@@ -81,7 +113,7 @@ public:
 
     ThreadSafeIterator& operator--()
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
 
         if (iterator != data->begin())
             --iterator;
@@ -91,7 +123,7 @@ public:
 
     ThreadSafeIterator operator--(int)
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
 
         ThreadSafeIterator temp = *this;
         --(*this);
@@ -99,21 +131,21 @@ public:
         return temp;
     }
 
-    T& operator*()
+    reference operator*()
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
         return *iterator;
     }
 
-    const T& operator*() const
+    const_reference operator*() const
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
         return *iterator;
     }
 
     bool operator==(const ThreadSafeIterator& other) const
     {
-        std::lock_guard<std::mutex> lock(*this->lock);
+        std::lock_guard<lock_type> lock(*this->lock);
         return iterator == other.iterator && data == other.data;
     }
 
@@ -122,23 +154,37 @@ public:
         return !(*this == other);
     }
 
-    static ThreadSafeIterator Begin(string_type& str, lock_pointer_type lock)
+    static ThreadSafeIterator Begin(container_type& str, lock_pointer_type lock)
     {
         return ThreadSafeIterator(str, lock);
     }
 
-    static ThreadSafeIterator End(string_type& str, lock_pointer_type lock)
+    static ThreadSafeIterator End(container_type& str, lock_pointer_type lock)
     {
         return ThreadSafeIterator(str, lock, true);
     }
 
+    static lock_pointer_type StripedLock(const void* owner)
+    {
+        static Stripe stripes[StripeCount];
+        return lock_pointer_type(lock_pointer_type(), &stripes[(reinterpret_cast<std::uintptr_t>(owner) >> 6) % StripeCount].mutex);
+    }
+
 private:
-    string_type* data;
+
+    static constexpr size_t StripeCount = 64;
+
+    struct alignas(64) Stripe
+    {
+        lock_type mutex;
+    };
+
+    container_type* data;
     iterator_type iterator;
     lock_pointer_type lock;
 };
 
-template <typename T>
+template <typename T, typename LockPolicy = SharedMutexLockPolicy, typename Allocator = std::allocator<T>>
 class AtomicString
 {
     static_assert(
@@ -149,49 +195,254 @@ class AtomicString
 
 public:
 
-    using string_type = std::basic_string<T>;
-    using mutex_type = std::shared_mutex;
+    using allocator_type = Allocator;
+    using string_type = std::basic_string<T, std::char_traits<T>, Allocator>;
+    using view_type = std::basic_string_view<T>;
+#if defined(ATOMICBASE_INSTRUMENTATION)
+    using mutex_type = InstrumentedMutex<typename LockPolicy::mutex_type>;
+#else
+    using mutex_type = typename LockPolicy::mutex_type;
+#endif
+    using journal_type = EditJournal<T>;
+    using iterator_type = ThreadSafeIterator<T, LockPolicy, string_type>;
+
+    class LockedView
+    {
 
-    AtomicString() = default;
-    ~AtomicString() = default;
+    public:
 
-    AtomicString& operator=(const AtomicString& other) = delete;
+        using iterator = const T*;
+        using const_iterator = const T*;
+
+        explicit LockedView(const AtomicString& owner) : lock(owner.mutex), data(owner.data) {}
+
+        view_type View() const
+        {
+            return data;
+        }
+
+        std::span<const T> Span() const
+        {
+            return std::span<const T>(data.data(), data.length());
+        }
+
+        const T* begin() const
+        {
+            return data.data();
+        }
+
+        const T* end() const
+        {
+            return data.data() + data.length();
+        }
+
+        const T& operator[](size_t index) const
+        {
+            return data[index];
+        }
+
+        size_t Length() const
+        {
+            return data.length();
+        }
+
+        operator view_type() const
+        {
+            return data;
+        }
+
+    private:
+
+        std::shared_lock<mutex_type> lock;
+        view_type data;
+
+    };
 
-    AtomicString(AtomicString&& other) noexcept
+    class WriteGuard
     {
-        std::unique_lock<std::shared_mutex> lock(other.mutex);
-        data = std::move(other.data);
-    }
 
-    template <typename U>
-    AtomicString(const std::basic_string<U>& str)
+    public:
+
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        explicit WriteGuard(AtomicString& owner) : lock(owner.mutex), data(&owner.data)
+        {
+            owner.BeginUnrecordedWrite();
+        }
+
+        string_type& String()
+        {
+            return *data;
+        }
+
+        view_type View() const
+        {
+            return *data;
+        }
+
+        std::span<T> Span()
+        {
+            return std::span<T>(data->data(), data->length());
+        }
+
+        T* begin()
+        {
+            return data->data();
+        }
+
+        T* end()
+        {
+            return data->data() + data->length();
+        }
+
+        T& operator[](size_t index)
+        {
+            return (*data)[index];
+        }
+
+        size_t Length() const
+        {
+            return data->length();
+        }
+
+    private:
+
+        std::unique_lock<mutex_type> lock;
+        string_type* data;
+
+    };
+
+    class Subscription
     {
-        data = Convert<U, T>(str);
-    }
 
-    template <typename U>
-    AtomicString(const U* str)
+    public:
+
+        Subscription() = default;
+
+        void Stop()
+        {
+            worker.request_stop();
+
+            if (worker.joinable() && worker.get_id() != std::this_thread::get_id())
+                worker.join();
+        }
+
+        bool Active() const
+        {
+            return worker.joinable();
+        }
+
+    private:
+
+        friend class AtomicString;
+
+        explicit Subscription(std::jthread worker) : worker(std::move(worker)) {}
+
+        std::jthread worker;
+
+    };
+
+    template <bool Exclusive, typename F, typename Executor>
+    class AsyncAccess
+    {
+
+    public:
+
+        using owner_type = std::conditional_t<Exclusive, AtomicString, const AtomicString>;
+
+        bool await_ready()
+        {
+            return acquire.await_ready();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            return acquire.await_suspend(awaiting);
+        }
+
+        decltype(auto) await_resume()
+        {
+            if constexpr (Exclusive)
+            {
+                std::unique_lock<AsyncSharedMutex> lock(owner.AsyncMutex(), std::adopt_lock);
+                owner.BeginUnrecordedWrite();
+
+                return function(owner.data);
+            }
+            else
+            {
+                std::shared_lock<AsyncSharedMutex> lock(owner.AsyncMutex(), std::adopt_lock);
+
+                return function(static_cast<const string_type&>(owner.data));
+            }
+        }
+
+    private:
+
+        friend class AtomicString;
+
+        AsyncAccess(owner_type& owner, F&& function, Executor executor) : owner(owner), function(std::forward<F>(function)), acquire(owner.AsyncMutex(), Exclusive, std::move(executor)) {}
+
+        owner_type& owner;
+        F function;
+        AsyncSharedMutex::Acquire<Executor> acquire;
+
+    };
+
+    AtomicString() = default;
+
+    ~AtomicString()
     {
-        data = Convert<U, T>(std::basic_string<U>(str));
+        if (journaled.load(std::memory_order_relaxed))
+            journal_type::Detach(this);
     }
 
+    AtomicString& operator=(const AtomicString& other) = delete;
+
+    explicit AtomicString(const allocator_type& allocator) : data(allocator) {}
+
+    AtomicString(AtomicString&& other) noexcept : AtomicString(std::move(other), std::unique_lock<mutex_type>(other.mutex)) {}
+
+    AtomicString(string_type&& str) : data(std::move(str)) {}
+
+    AtomicString(view_type str, const allocator_type& allocator = allocator_type()) : data(str, allocator) {}
+
+    template <typename U>
+    AtomicString(const std::basic_string<U>& str, const allocator_type& allocator = allocator_type()) : data(Converted<U>(str, allocator)) {}
+
+    template <typename U>
+    AtomicString(const std::basic_string<U>& str, ThreadPool& pool, const allocator_type& allocator = allocator_type()) : data(ConvertParallel<U, T>(str, pool, allocator)) {}
+
+    template <typename U>
+    AtomicString(const U* str, const allocator_type& allocator = allocator_type()) : data(Converted<U>(str, allocator)) {}
+
     AtomicString& operator=(AtomicString&& other) noexcept
     {
+        ATOMICBASE_OPERATION(Assign);
+
         if (this != &other)
         {
             std::scoped_lock lock(mutex, other.mutex);
             data = std::move(other.data);
+
+            BeginUnrecordedWrite();
+            cachedHash.store(other.cachedHash.load(std::memory_order_relaxed), std::memory_order_release);
+            hashCacheable.store(other.hashCacheable.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other.BeginUnrecordedWrite();
         }
 
         return *this;
     }
 
-    template <typename U>
-    AtomicString& operator=(const AtomicString<U>& input)
+    template <typename U, typename P, typename A>
+    AtomicString& operator=(const AtomicString<U, P, A>& input)
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
+        ATOMICBASE_OPERATION(Assign);
 
-        data = Convert<U, T>(input);
+        string_type converted = Converted<U>(input);
+
+        Modify([&converted](string_type& str) { str = std::move(converted); });
 
         return *this;
     }
@@ -199,9 +450,11 @@ public:
     template <typename U>
     AtomicString& operator=(const std::basic_string<U>& input)
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
+        ATOMICBASE_OPERATION(Assign);
+
+        auto operand = Operand(input);
 
-        data = Convert<U, T>(input);
+        Modify([&operand](string_type& str) { str = std::move(operand); });
 
         return *this;
     }
@@ -209,189 +462,269 @@ public:
     template <typename U>
     AtomicString& operator=(const U* str)
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
+        ATOMICBASE_OPERATION(Assign);
 
-        data = Convert<U, T>(std::basic_string<U>(str));
+        auto operand = Operand(str);
+
+        Modify([&operand](string_type& target) { target = std::move(operand); });
 
         return *this;
     }
 
-    template <typename U>
-    bool operator==(const AtomicString<U>& other) const
+    AtomicString& operator=(string_type&& input)
+    {
+        ATOMICBASE_OPERATION(Assign);
+
+        Modify([&input](string_type& str) { str = std::move(input); });
+
+        return *this;
+    }
+
+    template <typename U, typename P, typename A>
+    bool operator==(const AtomicString<U, P, A>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data == Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return view_type(str) == operand; });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return str == converted; });
+        }
     }
 
     template <typename U>
     bool operator==(const std::basic_string<U>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data == Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) == view_type(operand); });
     }
 
     template <typename U>
     bool operator==(const U* other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data == Convert<U, T>(std::basic_string<U>(other));
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) == view_type(operand); });
     }
 
-    template <typename U>
-    bool operator!=(const AtomicString<U>& other) const
+    template <typename U, typename P, typename A>
+    bool operator!=(const AtomicString<U, P, A>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data != Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return view_type(str) != operand; });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return str != converted; });
+        }
     }
 
     template <typename U>
     bool operator!=(const std::basic_string<U>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data != Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) != view_type(operand); });
     }
 
     template <typename U>
     bool operator!=(const U* other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data != Convert<U, T>(std::basic_string<U>(other));
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) != view_type(operand); });
     }
 
-    template <typename U>
-    bool operator<(const AtomicString<U>& other) const
+    template <typename U, typename P, typename A>
+    bool operator<(const AtomicString<U, P, A>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data < Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return view_type(str) < operand; });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return str < converted; });
+        }
     }
 
     template <typename U>
     bool operator<(const std::basic_string<U>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data < Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) < view_type(operand); });
     }
 
     template <typename U>
     bool operator<(const U* other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data < Convert<U, T>(std::basic_string<U>(other));
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) < view_type(operand); });
     }
 
-    template <typename U>
-    bool operator<=(const AtomicString<U>& other) const
+    template <typename U, typename P, typename A>
+    bool operator<=(const AtomicString<U, P, A>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data <= Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return view_type(str) <= operand; });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return str <= converted; });
+        }
     }
 
     template <typename U>
     bool operator<=(const std::basic_string<U>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data <= Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) <= view_type(operand); });
     }
 
     template <typename U>
     bool operator<=(const U* other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data <= Convert<U, T>(std::basic_string<U>(other));
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) <= view_type(operand); });
     }
 
-    template <typename U>
-    bool operator>(const AtomicString<U>& other) const
+    template <typename U, typename P, typename A>
+    bool operator>(const AtomicString<U, P, A>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data > Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return view_type(str) > operand; });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return str > converted; });
+        }
     }
 
     template <typename U>
     bool operator>(const std::basic_string<U>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data > Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) > view_type(operand); });
     }
 
     template <typename U>
     bool operator>(const U* other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data > Convert<U, T>(std::basic_string<U>(other));
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) > view_type(operand); });
     }
 
-    template <typename U>
-    bool operator>=(const AtomicString<U>& other) const
+    template <typename U, typename P, typename A>
+    bool operator>=(const AtomicString<U, P, A>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data >= Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return view_type(str) >= operand; });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return str >= converted; });
+        }
     }
 
     template <typename U>
     bool operator>=(const std::basic_string<U>& other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data >= Convert<U, T>(other);
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) >= view_type(operand); });
     }
 
     template <typename U>
     bool operator>=(const U* other) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return data >= Convert<U, T>(std::basic_string<U>(other));
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return view_type(str) >= view_type(operand); });
     }
 
-    template <typename U>
-    AtomicString operator+(const AtomicString<U>& other) const
+    template <typename U, typename P, typename A>
+    AtomicString operator+(const AtomicString<U, P, A>& other) const
     {
-        AtomicString<T> otherConverted(other);
-
-        std::scoped_lock lock(mutex, otherConverted.mutex);
-
-        AtomicString<T> result;
+        ATOMICBASE_OPERATION(Append);
 
-        result.data = this->data + otherConverted.data;
-
-        return result;
+        if constexpr (std::is_same<U, T>::value)
+            return AtomicString(ReadWith(other, [](const string_type& str, view_type operand) { return Concatenate(str, operand); }));
+        else
+            return *this + Converted<U>(other);
     }
 
     template <typename U>
     AtomicString operator+(const std::basic_string<U>& other) const
     {
-        AtomicString<T> otherConverted(other);
-
-        std::scoped_lock lock(mutex, otherConverted.mutex);
+        ATOMICBASE_OPERATION(Append);
 
-        AtomicString<T> result;
-
-        result.data = this->data + otherConverted.data;
-
-        return result;
+        auto operand = Operand(other);
+        return AtomicString(Read([&operand](const string_type& str) { return Concatenate(str, operand); }));
     }
 
     template <typename U>
     AtomicString operator+(const U* other) const
     {
-        AtomicString<T> otherConverted(other);
-
-        std::scoped_lock lock(mutex, otherConverted.mutex);
+        ATOMICBASE_OPERATION(Append);
 
-        AtomicString<T> result;
+        auto operand = Operand(other);
+        return AtomicString(Read([&operand](const string_type& str) { return Concatenate(str, operand); }));
+    }
 
-        result.data = this->data + otherConverted.data;
+    AtomicString operator+(view_type other) const
+    {
+        ATOMICBASE_OPERATION(Append);
 
-        return result;
+        return AtomicString(Read([other](const string_type& str) { return Concatenate(str, other); }));
     }
 
-    template <typename U>
-    AtomicString& operator+=(const AtomicString<U>& other)
+    AtomicString operator+(string_type&& other) const
     {
-        AtomicString<T> otherConverted(other);
+        ATOMICBASE_OPERATION(Append);
 
-        std::scoped_lock lock(mutex, otherConverted.mutex);
+        Read([&other](const string_type& str) { other.insert(0, str); });
+        return AtomicString(std::move(other));
+    }
+
+    template <typename U, typename P, typename A>
+    AtomicString& operator+=(const AtomicString<U, P, A>& other)
+    {
+        ATOMICBASE_OPERATION(Append);
 
-        this->data += otherConverted.data;
+        if constexpr (std::is_same<U, T>::value)
+            ModifyWith(other, [this](string_type& str, view_type operand) { AppendRecorded(str, operand); });
+        else
+            *this += Converted<U>(other);
 
         return *this;
     }
@@ -399,11 +732,10 @@ public:
     template <typename U>
     AtomicString& operator+=(const std::basic_string<U>& other)
     {
-        AtomicString<T> otherConverted(other);
+        ATOMICBASE_OPERATION(Append);
 
-        std::scoped_lock lock(mutex, otherConverted.mutex);
-
-        this->data += otherConverted.data;
+        auto operand = Operand(other);
+        Edit([this, &operand](string_type& str) { AppendRecorded(str, operand); });
 
         return *this;
     }
@@ -411,276 +743,1153 @@ public:
     template <typename U>
     AtomicString& operator+=(const U* other)
     {
-        AtomicString<T> otherConverted(other);
-
-        std::scoped_lock lock(mutex, otherConverted.mutex);
+        ATOMICBASE_OPERATION(Append);
 
-        this->data += otherConverted.data;
+        auto operand = Operand(other);
+        Edit([this, &operand](string_type& str) { AppendRecorded(str, operand); });
 
         return *this;
     }
 
-    template <typename U>
-    AtomicString operator-(const AtomicString<U>& other) const
+    AtomicString& operator+=(view_type other)
     {
-        AtomicString<T> otherConverted(other);
+        ATOMICBASE_OPERATION(Append);
+
+        Edit([this, other](string_type& str) { AppendRecorded(str, other); });
 
-        std::scoped_lock lock(mutex, otherConverted.mutex);
+        return *this;
+    }
 
-        AtomicString<T> result;
+    AtomicString& operator+=(string_type&& other)
+    {
+        ATOMICBASE_OPERATION(Append);
 
-        result.data = this->data;
+        Edit([this, &other](string_type& str)
+        {
+            journal_type* journal = Journal();
+            size_t offset = str.length();
+            size_t length = str.length() + other.length();
+
+            if (str.empty())
+                str = std::move(other);
+            else if (str.capacity() < length && other.capacity() >= length && str.get_allocator() == other.get_allocator())
+            {
+                other.insert(0, str);
+                str.swap(other);
+            }
+            else
+                str.append(other);
+
+            RecordEdit(journal, offset, 0, view_type(str).substr(offset));
+        });
 
-        size_t position = result.data.find(otherConverted.data);
+        return *this;
+    }
 
-        if (position != std::basic_string<T>::npos)
-            result.data.erase(position, otherConverted.data.length());
+    template <typename U, typename P, typename A>
+    AtomicString operator-(const AtomicString<U, P, A>& other) const
+    {
+        ATOMICBASE_OPERATION(Remove);
 
-        return result;
+        if constexpr (std::is_same<U, T>::value)
+            return AtomicString(ReadWith(other, [](const string_type& str, view_type operand) { return RemoveFirst(str, operand); }));
+        else
+            return *this - view_type(Converted<U>(other));
     }
 
     template <typename U>
     AtomicString operator-(const std::basic_string<U>& other) const
     {
-        AtomicString<T> otherConverted(other);
-
-        std::scoped_lock lock(mutex, otherConverted.mutex);
-
-        AtomicString<T> result;
-
-        result.data = this->data;
+        ATOMICBASE_OPERATION(Remove);
 
-        size_t position = result.data.find(otherConverted.data);
-
-        if (position != std::basic_string<T>::npos)
-            result.data.erase(position, otherConverted.data.length());
-
-        return result;
+        auto operand = Operand(other);
+        return AtomicString(Read([&operand](const string_type& str) { return RemoveFirst(str, operand); }));
     }
 
     template <typename U>
     AtomicString operator-(const U* other) const
     {
-        AtomicString<T> otherConverted(other);
+        ATOMICBASE_OPERATION(Remove);
 
-        std::scoped_lock lock(mutex, otherConverted.mutex);
+        auto operand = Operand(other);
+        return AtomicString(Read([&operand](const string_type& str) { return RemoveFirst(str, operand); }));
+    }
 
-        AtomicString<T> result;
+    AtomicString operator-(view_type other) const
+    {
+        ATOMICBASE_OPERATION(Remove);
 
-        result.data = this->data;
+        return AtomicString(Read([other](const string_type& str) { return RemoveFirst(str, other); }));
+    }
 
-        size_t position = result.data.find(otherConverted.data);
+    template <typename U, typename P, typename A>
+    AtomicString& operator-=(const AtomicString<U, P, A>& other)
+    {
+        ATOMICBASE_OPERATION(Remove);
 
-        if (position != std::basic_string<T>::npos)
-            result.data.erase(position, otherConverted.data.length());
+        if constexpr (std::is_same<U, T>::value)
+            ModifyWith(other, [this](string_type& str, view_type operand) { EraseFirst(str, operand); });
+        else
+            *this -= view_type(Converted<U>(other));
 
-        return result;
+        return *this;
     }
 
     template <typename U>
-    AtomicString& operator-=(const AtomicString<U>& other)
+    AtomicString& operator-=(const std::basic_string<U>& other)
     {
-        AtomicString<T> otherConverted(other);
-        std::scoped_lock lock(mutex, otherConverted.mutex);
-        size_t position = data.find(otherConverted.data);
+        ATOMICBASE_OPERATION(Remove);
 
-        if (position != std::basic_string<T>::npos)
-            data.erase(position, otherConverted.data.length());
+        auto operand = Operand(other);
+        Edit([this, &operand](string_type& str) { EraseFirst(str, operand); });
 
         return *this;
     }
 
     template <typename U>
-    AtomicString& operator-=(const std::basic_string<U>& other)
+    AtomicString& operator-=(const U* other)
     {
-        AtomicString<T> otherConverted(other);
-        std::scoped_lock lock(mutex, otherConverted.mutex);
-        size_t position = data.find(otherConverted.data);
+        ATOMICBASE_OPERATION(Remove);
 
-        if (position != std::basic_string<T>::npos)
-            data.erase(position, otherConverted.data.length());
+        auto operand = Operand(other);
+        Edit([this, &operand](string_type& str) { EraseFirst(str, operand); });
 
         return *this;
     }
 
-    template <typename U>
-    AtomicString& operator-=(const U* other)
+    AtomicString& operator-=(view_type other)
     {
-        AtomicString<T> otherConverted(other);
-        std::scoped_lock lock(mutex, otherConverted.mutex);
-        size_t position = data.find(otherConverted.data);
+        ATOMICBASE_OPERATION(Remove);
 
-        if (position != std::basic_string<T>::npos)
-            data.erase(position, otherConverted.data.length());
+        Edit([this, other](string_type& str) { EraseFirst(str, other); });
 
         return *this;
     }
 
     T& operator[](size_t index)
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
+        ATOMICBASE_OPERATION(Read);
+
+        std::shared_lock<mutex_type> lock(mutex);
+        BeginUntrackedAccess();
         return data[index];
     }
 
-    template <typename F, typename L>
-    void FindAndReplace(const AtomicString<F>& find, const AtomicString<L>& replace)
+    template <typename F>
+    auto Modify(F&& function)
     {
-        std::scoped_lock lock(mutex, find.mutex, replace.mutex);
-
-        size_t pos = 0;
+        ATOMICBASE_OPERATION(Modify);
 
-        while ((pos = data.find(find.data, pos)) != std::basic_string<T>::npos)
-        {
-            data.replace(pos, find.data.length(), replace.data);
-            pos += replace.data.length();
-        }
+        std::unique_lock<mutex_type> lock(mutex);
+        BeginUnrecordedWrite();
+        return std::forward<F>(function)(data);
     }
 
-    template <typename F, typename L>
-    void FindAndReplace(const std::basic_string<F>& find, const std::basic_string<L>& replace)
+    template <typename F>
+    auto Read(F&& function) const
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
+        ATOMICBASE_OPERATION(Read);
 
-        size_t pos = 0;
-
-        while ((pos = data.find(find, pos)) != std::basic_string<T>::npos)
-        {
-            data.replace(pos, find.length(), replace);
-            pos += replace.length();
-        }
+        std::shared_lock<mutex_type> lock(mutex);
+        return std::forward<F>(function)(static_cast<const string_type&>(data));
     }
 
-    template <typename F, typename L>
-    void FindAndReplace(const F* find, const L* replace)
+    template <typename F>
+    auto ReadHashed(F&& function) const
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
-
-        size_t pos = 0;
+        ATOMICBASE_OPERATION(Hash);
 
-        while ((pos = data.find(find, pos)) != std::basic_string<T>::npos)
-        {
-            data.replace(pos, std::char_traits<F>::length(find), replace);
-            pos += std::char_traits<L>::length(replace);
-        }
+        std::shared_lock<mutex_type> lock(mutex);
+        return std::forward<F>(function)(static_cast<const string_type&>(data), HashOf(data));
     }
 
-    void ToUpper()
+    std::uint64_t Version() const
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
-        std::transform(data.begin(), data.end(), data.begin(), ::toupper);
+        return version.load(std::memory_order_acquire);
     }
 
-    void ToLower()
+    bool WaitForChange(std::uint64_t lastVersion, std::chrono::nanoseconds timeout = AddressWait::Infinite) const
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
-        std::transform(data.begin(), data.end(), data.begin(), ::tolower);
+        return WaitUntilChanged(lastVersion, timeout, nullptr);
     }
 
-    ThreadSafeIterator<T> begin() 
+    bool WaitForChange(std::uint64_t lastVersion, std::stop_token token) const
     {
-        return ThreadSafeIterator<T>::Begin(data, iteratorMutex);
+        std::stop_callback wake(token, [this] { WakeWaiters(); });
+
+        return WaitUntilChanged(lastVersion, AddressWait::Infinite, &token);
     }
 
-    ThreadSafeIterator<T> end() 
+    template <typename F>
+    Subscription Subscribe(F&& callback) const
     {
-        return ThreadSafeIterator<T>::End(data, iteratorMutex);
-    }
+        std::uint64_t seen = Version();
 
-	size_t Length() const
-	{
-		std::shared_lock<std::shared_mutex> lock(mutex);
-		return data.length();
-	}
+        return Subscription(std::jthread([this, seen, callback = std::forward<F>(callback)](std::stop_token token) mutable
+        {
+            while (WaitForChange(seen, token))
+            {
+                string_type value = Load(seen);
+                callback(static_cast<const string_type&>(value), seen);
+            }
+        }));
+    }
 
-    void Clear()
+    template <typename F, typename Executor = AsyncSharedMutex::InlineExecutor>
+    AsyncAccess<true, F, Executor> ModifyAsync(F&& function, Executor executor = Executor())
     {
-        std::unique_lock<std::shared_mutex> lock(mutex);
-        data.clear();
+        static_assert(std::is_same<typename LockPolicy::mutex_type, AsyncSharedMutex>::value, "ModifyAsync requires AsyncLockPolicy.");
+
+        return AsyncAccess<true, F, Executor>(*this, std::forward<F>(function), std::move(executor));
     }
 
-    template <typename U>
-    operator std::basic_string<U>() const
+    template <typename F, typename Executor = AsyncSharedMutex::InlineExecutor>
+    AsyncAccess<false, F, Executor> ReadAsync(F&& function, Executor executor = Executor()) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return Convert<T, U>(data);
+        static_assert(std::is_same<typename LockPolicy::mutex_type, AsyncSharedMutex>::value, "ReadAsync requires AsyncLockPolicy.");
+
+        return AsyncAccess<false, F, Executor>(*this, std::forward<F>(function), std::move(executor));
     }
 
-    template <typename U>
-    operator const U* () const
+    string_type Load(std::uint64_t& observed) const
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return Convert<T, U>(data).c_str();
-    }
+        ATOMICBASE_OPERATION(Read);
 
-private:
+        std::shared_lock<mutex_type> lock(mutex);
+
+        observed = version.load(std::memory_order_relaxed);
+        ATOMICBASE_RECORD_BYTES(mutex, data.length() * sizeof(T));
+
+        return string_type(data, data.get_allocator());
+    }
+
+    bool CompareExchange(string_type& expected, view_type desired)
+    {
+        ATOMICBASE_OPERATION(Compare);
+
+        std::unique_lock<mutex_type> lock(mutex);
+
+        if (view_type(data) != view_type(expected))
+        {
+            expected.assign(data);
+            return false;
+        }
+
+        BeginUnrecordedWrite();
+        data.assign(desired);
+
+        return true;
+    }
+
+    template <typename F>
+    bool UpdateIf(std::uint64_t expected, F&& function)
+    {
+        ATOMICBASE_OPERATION(Modify);
+
+        std::unique_lock<mutex_type> lock(mutex);
+
+        if (version.load(std::memory_order_relaxed) != expected)
+            return false;
+
+        BeginUnrecordedWrite();
+        std::forward<F>(function)(data);
+
+        return true;
+    }
+
+    size_t Hash() const
+    {
+        ATOMICBASE_OPERATION(Hash);
+
+        if (hashCacheable.load(std::memory_order_acquire))
+        {
+            size_t hash = cachedHash.load(std::memory_order_acquire);
+
+            if (hash != 0)
+                return hash;
+        }
+
+        return Read([this](const string_type& str) { return HashOf(str); });
+    }
+
+    template <typename F, typename FP, typename FA, typename L, typename LP, typename LA>
+    void FindAndReplace(const AtomicString<F, FP, FA>& find, const AtomicString<L, LP, LA>& replace)
+    {
+        ATOMICBASE_OPERATION(FindAndReplace);
+
+        string_type findConverted = Converted<F>(find);
+        string_type replaceConverted = Converted<L>(replace);
+
+        Edit([this, &findConverted, &replaceConverted](string_type& str) { ReplaceAll(str, findConverted, replaceConverted); });
+    }
 
     template <typename F, typename L>
-	AtomicString<L> Convert(const AtomicString<F>& from) const
+    void FindAndReplace(const std::basic_string<F>& find, const std::basic_string<L>& replace)
     {
-        std::shared_lock<std::shared_mutex> lock(mutex);
-        return Convert<F, L>(from.data);
+        ATOMICBASE_OPERATION(FindAndReplace);
+
+        string_type findConverted = Converted<F>(find);
+        string_type replaceConverted = Converted<L>(replace);
+
+        Edit([this, &findConverted, &replaceConverted](string_type& str) { ReplaceAll(str, findConverted, replaceConverted); });
     }
 
     template <typename F, typename L>
-    std::basic_string<L> Convert(const std::basic_string<F>& from) const
+    void FindAndReplace(const F* find, const L* replace)
     {
-        static_assert(
-            std::is_same<F, char>::value || std::is_same<F, wchar_t>::value ||
-            std::is_same<F, char16_t>::value || std::is_same<F, char32_t>::value,
-            "Convert only supports char, wchar_t, char16_t, and char32_t types."
-            );
+        ATOMICBASE_OPERATION(FindAndReplace);
 
-        static_assert(
-            std::is_same<L, char>::value || std::is_same<L, wchar_t>::value ||
-            std::is_same<L, char16_t>::value || std::is_same<L, char32_t>::value,
-            "Convert only supports char, wchar_t, char16_t, and char32_t types."
-            );
+        string_type findConverted = Converted<F>(find);
+        string_type replaceConverted = Converted<L>(replace);
 
-        if constexpr (std::is_same<F, L>::value)
-            return from;
-        else if constexpr (std::is_same<F, char>::value && std::is_same<L, wchar_t>::value)
+        Edit([this, &findConverted, &replaceConverted](string_type& str) { ReplaceAll(str, findConverted, replaceConverted); });
+    }
+
+    template <typename F, typename L>
+    void FindAndReplace(const std::basic_string<F>& find, const std::basic_string<L>& replace, ThreadPool& pool)
+    {
+        ATOMICBASE_OPERATION(FindAndReplace);
+
+        string_type findConverted = Converted<F>(find);
+        string_type replaceConverted = Converted<L>(replace);
+
+        Edit([this, &findConverted, &replaceConverted, &pool](string_type& str)
         {
-            std::basic_string<L> result(from.size(), L'\0');
+            journal_type* journal = Journal();
+            std::vector<size_t> positions = ReplacePositions(journal, str, findConverted);
 
-            std::mbstowcs(result.data(), from.c_str(), from.size());
+            ParallelTransform::ReplaceAll<T>(str, findConverted, replaceConverted, pool);
+            RecordReplace(journal, positions, findConverted, replaceConverted);
+        });
+    }
 
-            return result;
+    template <typename F, typename L>
+    void FindAndReplace(const F* find, const L* replace, ThreadPool& pool)
+    {
+        ATOMICBASE_OPERATION(FindAndReplace);
+
+        string_type findConverted = Converted<F>(find);
+        string_type replaceConverted = Converted<L>(replace);
+
+        Edit([this, &findConverted, &replaceConverted, &pool](string_type& str)
+        {
+            journal_type* journal = Journal();
+            std::vector<size_t> positions = ReplacePositions(journal, str, findConverted);
+
+            ParallelTransform::ReplaceAll<T>(str, findConverted, replaceConverted, pool);
+            RecordReplace(journal, positions, findConverted, replaceConverted);
+        });
+    }
+
+    void FindAndReplace(const ReplaceSet<T>& replacements)
+    {
+        ATOMICBASE_OPERATION(FindAndReplace);
+
+        Modify([&replacements](string_type& str) { replacements.ApplyTo(str); });
+    }
+
+    size_t Find(const Searcher<T>& searcher, size_t from = 0) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Read([&searcher, from](const string_type& str) { return searcher.Find(str, from); });
+    }
+
+    template <typename U, typename P, typename A>
+    size_t Find(const AtomicString<U, P, A>& needle, size_t from = 0) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Find(Searcher<T>(Converted<U>(needle)), from);
+    }
+
+    template <typename U>
+    size_t Find(const std::basic_string<U>& needle, size_t from = 0) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Find(Searcher<T>(Operand(needle)), from);
+    }
+
+    template <typename U>
+    size_t Find(const U* needle, size_t from = 0) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Find(Searcher<T>(Operand(needle)), from);
+    }
+
+    bool Contains(const Searcher<T>& searcher) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Read([&searcher](const string_type& str) { return searcher.Contains(str); });
+    }
+
+    template <typename U, typename P, typename A>
+    bool Contains(const AtomicString<U, P, A>& needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Contains(Searcher<T>(Converted<U>(needle)));
+    }
+
+    template <typename U>
+    bool Contains(const std::basic_string<U>& needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Contains(Searcher<T>(Operand(needle)));
+    }
+
+    template <typename U>
+    bool Contains(const U* needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Contains(Searcher<T>(Operand(needle)));
+    }
+
+    size_t Count(const Searcher<T>& searcher) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Read([&searcher](const string_type& str) { return searcher.Count(str); });
+    }
+
+    template <typename U, typename P, typename A>
+    size_t Count(const AtomicString<U, P, A>& needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Count(Searcher<T>(Converted<U>(needle)));
+    }
+
+    template <typename U>
+    size_t Count(const std::basic_string<U>& needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Count(Searcher<T>(Operand(needle)));
+    }
+
+    template <typename U>
+    size_t Count(const U* needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Count(Searcher<T>(Operand(needle)));
+    }
+
+    std::vector<size_t> FindAll(const Searcher<T>& searcher) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return Read([&searcher](const string_type& str) { return searcher.FindAll(str); });
+    }
+
+    template <typename U, typename P, typename A>
+    std::vector<size_t> FindAll(const AtomicString<U, P, A>& needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return FindAll(Searcher<T>(Converted<U>(needle)));
+    }
+
+    template <typename U>
+    std::vector<size_t> FindAll(const std::basic_string<U>& needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return FindAll(Searcher<T>(Operand(needle)));
+    }
+
+    template <typename U>
+    std::vector<size_t> FindAll(const U* needle) const
+    {
+        ATOMICBASE_OPERATION(Search);
+
+        return FindAll(Searcher<T>(Operand(needle)));
+    }
+
+    void ToUpper()
+    {
+        ATOMICBASE_OPERATION(ToUpper);
+
+        Modify([](string_type& str) { CaseConversion::ToUpper(str.data(), str.length()); });
+    }
+
+    void ToLower()
+    {
+        ATOMICBASE_OPERATION(ToLower);
+
+        Modify([](string_type& str) { CaseConversion::ToLower(str.data(), str.length()); });
+    }
+
+    void ToUpper(ThreadPool& pool)
+    {
+        ATOMICBASE_OPERATION(ToUpper);
+
+        Modify([&pool](string_type& str) { ParallelTransform::ToUpper(str.data(), str.length(), pool); });
+    }
+
+    void ToLower(ThreadPool& pool)
+    {
+        ATOMICBASE_OPERATION(ToLower);
+
+        Modify([&pool](string_type& str) { ParallelTransform::ToLower(str.data(), str.length(), pool); });
+    }
+
+    template <typename U>
+    std::basic_string<U> ConvertTo(ThreadPool& pool) const
+    {
+        ATOMICBASE_OPERATION(Convert);
+
+        return Read([this, &pool](const string_type& str)
+        {
+            ATOMICBASE_RECORD_BYTES(mutex, str.length() * sizeof(T));
+            return ConvertParallel<T, U>(str, pool);
+        });
+    }
+
+    template <typename U, typename P, typename A>
+    bool EqualsIgnoreCase(const AtomicString<U, P, A>& other) const
+    {
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return CaseConversion::EqualsIgnoreCase(view_type(str), operand); });
+        else
+        {
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return CaseConversion::EqualsIgnoreCase(view_type(str), view_type(converted)); });
         }
-        else if constexpr (std::is_same<F, wchar_t>::value && std::is_same<L, char>::value)
+    }
+
+    template <typename U>
+    bool EqualsIgnoreCase(const std::basic_string<U>& other) const
+    {
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return CaseConversion::EqualsIgnoreCase(view_type(str), view_type(operand)); });
+    }
+
+    template <typename U>
+    bool EqualsIgnoreCase(const U* other) const
+    {
+        ATOMICBASE_OPERATION(Compare);
+
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return CaseConversion::EqualsIgnoreCase(view_type(str), view_type(operand)); });
+    }
+
+    template <typename U, typename P, typename A>
+    int CompareIgnoreCase(const AtomicString<U, P, A>& other) const
+    {
+        ATOMICBASE_OPERATION(Compare);
+
+        if constexpr (std::is_same<U, T>::value)
+            return ReadWith(other, [](const string_type& str, view_type operand) { return CaseConversion::CompareIgnoreCase(view_type(str), operand); });
+        else
         {
-            std::basic_string<L> result(from.size() * MB_CUR_MAX, '\0');
+            string_type converted = Converted<U>(other);
+            return Read([&converted](const string_type& str) { return CaseConversion::CompareIgnoreCase(view_type(str), view_type(converted)); });
+        }
+    }
+
+    template <typename U>
+    int CompareIgnoreCase(const std::basic_string<U>& other) const
+    {
+        ATOMICBASE_OPERATION(Compare);
 
-            std::wcstombs(result.data(), from.c_str(), from.size() * MB_CUR_MAX);
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return CaseConversion::CompareIgnoreCase(view_type(str), view_type(operand)); });
+    }
 
-            result.resize(std::strlen(result.c_str()));
+    template <typename U>
+    int CompareIgnoreCase(const U* other) const
+    {
+        ATOMICBASE_OPERATION(Compare);
 
-            return result;
+        auto operand = Operand(other);
+        return Read([&operand](const string_type& str) { return CaseConversion::CompareIgnoreCase(view_type(str), view_type(operand)); });
+    }
+
+    LockedView View() const
+    {
+        ATOMICBASE_OPERATION(Read);
+
+        return LockedView(*this);
+    }
+
+    WriteGuard Write()
+    {
+        ATOMICBASE_OPERATION(Modify);
+
+        return WriteGuard(*this);
+    }
+
+    template <typename F>
+    void ForEachChunk(F&& function, size_t chunkSize = 4096) const
+    {
+        ATOMICBASE_OPERATION(Read);
+
+        if (chunkSize == 0)
+            throw std::runtime_error("Chunk size must be non-zero.");
+
+        Read([&function, chunkSize](const string_type& str)
+        {
+            view_type all(str);
+
+            for (size_t i = 0; i < all.length(); i += chunkSize)
+                function(all.substr(i, chunkSize));
+        });
+    }
+
+    template <typename F>
+    void ModifyEachChunk(F&& function, size_t chunkSize = 4096)
+    {
+        ATOMICBASE_OPERATION(Modify);
+
+        if (chunkSize == 0)
+            throw std::runtime_error("Chunk size must be non-zero.");
+
+        Modify([&function, chunkSize](string_type& str)
+        {
+            for (size_t i = 0; i < str.length(); i += chunkSize)
+                function(std::span<T>(str.data() + i, std::min(chunkSize, str.length() - i)));
+        });
+    }
+
+    iterator_type begin() 
+    {
+        ATOMICBASE_OPERATION(Iterate);
+
+        {
+            std::shared_lock<mutex_type> lock(mutex);
+            BeginUntrackedAccess();
+        }
+
+        return iterator_type::Begin(data, IteratorLock());
+    }
+
+    iterator_type end() 
+    {
+        ATOMICBASE_OPERATION(Iterate);
+
+        {
+            std::shared_lock<mutex_type> lock(mutex);
+            BeginUntrackedAccess();
+        }
+
+        return iterator_type::End(data, IteratorLock());
+    }
+
+    allocator_type GetAllocator() const
+    {
+        return data.get_allocator();
+    }
+
+#if defined(ATOMICBASE_INSTRUMENTATION)
+    std::shared_ptr<LockStatistics> Instrument()
+    {
+        return Instrument(std::make_shared<LockStatistics>());
+    }
+
+    std::shared_ptr<LockStatistics> Instrument(std::string_view tag)
+    {
+        return Instrument(LockStatistics::ForTag(tag));
+    }
+
+    std::shared_ptr<LockStatistics> Instrument(std::shared_ptr<LockStatistics> target)
+    {
+        std::unique_lock<mutex_type> lock(mutex);
+
+        statistics = std::move(target);
+        mutex.Attach(statistics.get());
+
+        return statistics;
+    }
+
+    std::shared_ptr<LockStatistics> Statistics() const
+    {
+        std::shared_lock<mutex_type> lock(mutex);
+        return statistics;
+    }
+#endif
+
+	size_t Length() const
+	{
+		ATOMICBASE_OPERATION(Read);
+
+		return Read([](const string_type& str) { return str.length(); });
+	}
+
+    void Clear()
+    {
+        ATOMICBASE_OPERATION(Modify);
+
+        Edit([this](string_type& str)
+        {
+            size_t erased = str.length();
+
+            str.clear();
+            RecordEdit(Journal(), 0, erased, view_type());
+        });
+    }
+
+    template <typename U, typename A>
+    void AppendTo(std::basic_string<U, std::char_traits<U>, A>& target) const
+    {
+        ATOMICBASE_OPERATION(Convert);
+
+        Read([this, &target](const string_type& str)
+        {
+            ATOMICBASE_RECORD_BYTES(mutex, str.length() * sizeof(T));
+
+            if constexpr (std::is_same<U, T>::value)
+                target.append(str);
+            else
+            {
+                size_t offset = target.length();
+
+                target.resize(offset + Transcoder::Measure<T, U>(str.data(), str.length()));
+                Transcoder::Write<T, U>(str.data(), str.length(), target.data() + offset);
+            }
+        });
+    }
+
+    void EnableJournal(typename journal_type::Options options = typename journal_type::Options())
+    {
+        std::unique_lock<mutex_type> lock(mutex);
+
+        journal_type::Attach(this, version.load(std::memory_order_relaxed), options);
+        journaled.store(true, std::memory_order_relaxed);
+    }
+
+    void DisableJournal()
+    {
+        std::unique_lock<mutex_type> lock(mutex);
+
+        if (journaled.exchange(false, std::memory_order_relaxed))
+            journal_type::Detach(this);
+    }
+
+    typename journal_type::Batch Changes(std::uint64_t since, size_t limit = journal_type::Unlimited) const
+    {
+        ATOMICBASE_OPERATION(Read);
+
+        std::shared_lock<mutex_type> lock(mutex);
+
+        typename journal_type::Batch batch;
+        std::uint64_t current = version.load(std::memory_order_relaxed);
+        const journal_type* journal = Journal();
+
+        if (journal == nullptr || !journal->Collect(since, current, limit, data.length(), batch))
+        {
+            batch = typename journal_type::Batch();
+            batch.from = since;
+            batch.to = current;
+            batch.snapshot = true;
+            batch.contents.assign(data.data(), data.length());
         }
+
+        return batch;
+    }
+
+    size_t LoadFromFile(const std::filesystem::path& path)
+    {
+        FileIO::Descriptor file(path);
+
+        return LoadFromFd(file.Get());
+    }
+
+    size_t LoadFromFd(int fd)
+    {
+        ATOMICBASE_OPERATION(Assign);
+
+        string_type loaded(data.get_allocator());
+        size_t bytes = FileIO::ReadInto(fd, loaded);
+
+        Modify([&loaded](string_type& str) { str = std::move(loaded); });
+
+        return bytes;
+    }
+
+    size_t AppendFromFd(int fd, size_t limit = FileIO::Unlimited, size_t chunkSize = FileIO::DefaultChunkSize)
+    {
+        ATOMICBASE_OPERATION(Append);
+
+        string_type loaded(data.get_allocator());
+        size_t bytes = FileIO::ReadInto(fd, loaded, limit, chunkSize);
+
+        if (!loaded.empty())
+            *this += std::move(loaded);
+
+        return bytes;
+    }
+
+    size_t WriteTo(int fd) const
+    {
+        ATOMICBASE_OPERATION(Read);
+
+        string_type snapshot(data.get_allocator());
+
+        AppendTo(snapshot);
+        FileIO::WriteAll(fd, snapshot.data(), snapshot.length() * sizeof(T));
+
+        return snapshot.length() * sizeof(T);
+    }
+
+    template <typename U>
+    operator std::basic_string<U>() const
+    {
+        ATOMICBASE_OPERATION(Convert);
+
+        return Read([this](const string_type& str)
+        {
+            ATOMICBASE_RECORD_BYTES(mutex, str.length() * sizeof(T));
+            return Convert<T, U>(str);
+        });
+    }
+
+    template <typename U>
+    operator const U* () const
+    {
+        ATOMICBASE_OPERATION(Convert);
+
+        std::shared_lock<mutex_type> lock(mutex);
+        ATOMICBASE_RECORD_BYTES(mutex, data.length() * sizeof(T));
+        return Convert<T, U>(data).c_str();
+    }
+
+private:
+
+    AtomicString(AtomicString&& other, std::unique_lock<mutex_type>&&) : data(std::move(other.data))
+    {
+        cachedHash.store(other.cachedHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        hashCacheable.store(other.hashCacheable.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.BeginUnrecordedWrite();
+    }
+
+    typename LockPolicy::mutex_type& AsyncMutex() const
+    {
+#if defined(ATOMICBASE_INSTRUMENTATION)
+        return mutex.Inner();
+#else
+        return mutex;
+#endif
+    }
+
+    typename iterator_type::lock_pointer_type IteratorLock() const
+    {
+        return iterator_type::StripedLock(this);
+    }
+
+    template <typename F>
+    auto Edit(F&& function)
+    {
+        ATOMICBASE_OPERATION(Modify);
+
+        std::unique_lock<mutex_type> lock(mutex);
+        BeginWrite();
+        return std::forward<F>(function)(data);
+    }
+
+    template <typename P, typename A, typename F>
+    auto ModifyWith(const AtomicString<T, P, A>& other, F&& function)
+    {
+        if (static_cast<const void*>(&other) == static_cast<const void*>(this))
+            return Edit([&function](string_type& str) { return function(str, view_type(str)); });
+
+        std::unique_lock<mutex_type> lock(mutex, std::defer_lock);
+        std::shared_lock<typename AtomicString<T, P, A>::mutex_type> otherLock(other.mutex, std::defer_lock);
+        std::lock(lock, otherLock);
+        BeginWrite();
+
+        return function(data, view_type(other.data));
+    }
+
+    template <typename P, typename A, typename F>
+    auto ReadWith(const AtomicString<T, P, A>& other, F&& function) const
+    {
+        if (static_cast<const void*>(&other) == static_cast<const void*>(this))
+            return Read([&function](const string_type& str) { return function(str, view_type(str)); });
+
+        std::shared_lock<mutex_type> lock(mutex, std::defer_lock);
+        std::shared_lock<typename AtomicString<T, P, A>::mutex_type> otherLock(other.mutex, std::defer_lock);
+        std::lock(lock, otherLock);
+
+        return function(static_cast<const string_type&>(data), view_type(other.data));
+    }
+
+    size_t HashOf(const string_type& str) const
+    {
+        if (!hashCacheable.load(std::memory_order_acquire))
+            return std::hash<view_type>{}(str);
+
+        size_t hash = cachedHash.load(std::memory_order_acquire);
+
+        if (hash != 0)
+            return hash;
+
+        hash = std::hash<view_type>{}(str);
+
+        if (hash != 0)
+            cachedHash.store(hash, std::memory_order_release);
+
+        return hash;
+    }
+
+    void BeginWrite()
+    {
+        cachedHash.store(0, std::memory_order_relaxed);
+        hashCacheable.store(true, std::memory_order_release);
+        version.fetch_add(1, std::memory_order_seq_cst);
+
+        if (waiters.load(std::memory_order_seq_cst) != 0)
+            WakeWaiters();
+    }
+
+    void BeginUnrecordedWrite()
+    {
+        BeginWrite();
+
+        if (journal_type* journal = Journal())
+            journal->Invalidate();
+    }
+
+    void WakeWaiters() const
+    {
+        changes.fetch_add(1, std::memory_order_seq_cst);
+        AddressWait::WakeAll(changes);
+    }
+
+    bool WaitUntilChanged(std::uint64_t lastVersion, std::chrono::nanoseconds timeout, const std::stop_token* token) const
+    {
+        if (version.load(std::memory_order_acquire) != lastVersion)
+            return true;
+
+        bool infinite = timeout == AddressWait::Infinite;
+        auto deadline = infinite ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now() + timeout;
+        bool changed = false;
+
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+
+        while (true)
+        {
+            std::uint32_t observed = changes.load(std::memory_order_seq_cst);
+
+            if (version.load(std::memory_order_seq_cst) != lastVersion)
+            {
+                changed = true;
+                break;
+            }
+
+            if (token != nullptr && token->stop_requested())
+                break;
+
+            std::chrono::nanoseconds remaining = infinite ? AddressWait::Infinite : deadline - std::chrono::steady_clock::now();
+
+            if (remaining <= std::chrono::nanoseconds::zero())
+                break;
+
+            AddressWait::Wait(changes, observed, remaining);
+        }
+
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        return changed;
+    }
+
+    // operator[] and the mutable iterators hand out references that bypass the
+    // write lock, so hashing stays uncached and Changes() returns snapshots until
+    // the next locked write. Writes through those references are not versioned.
+    void BeginUntrackedAccess()
+    {
+        hashCacheable.store(false, std::memory_order_release);
+        cachedHash.store(0, std::memory_order_relaxed);
+
+        if (journal_type* journal = Journal())
+            journal->Taint();
+    }
+
+    template <typename U>
+    auto Operand(const std::basic_string<U>& other) const
+    {
+        if constexpr (std::is_same<U, T>::value)
+            return view_type(other);
+        else
+            return Converted<U>(other);
+    }
+
+    template <typename U>
+    auto Operand(const U* other) const
+    {
+        if constexpr (std::is_same<U, T>::value)
+            return view_type(other);
+        else
+            return Converted<U>(other);
+    }
+
+    static string_type Concatenate(const string_type& str, view_type other)
+    {
+        string_type result(str.get_allocator());
+
+        result.reserve(str.length() + other.length());
+        result.append(str).append(other);
+
+        return result;
+    }
+
+    static string_type RemoveFirst(const string_type& str, view_type other)
+    {
+        size_t position = Searcher<T>(other).Find(str);
+
+        if (position == string_type::npos)
+            return string_type(str, str.get_allocator());
+
+        string_type result(str.get_allocator());
+
+        result.reserve(str.length() - other.length());
+        result.append(str, 0, position).append(str, position + other.length());
+
+        return result;
+    }
+
+    void EraseFirst(string_type& str, view_type other)
+    {
+        size_t position = Searcher<T>(other).Find(str);
+
+        if (position == string_type::npos)
+            return;
+
+        str.erase(position, other.length());
+        RecordEdit(Journal(), position, other.length(), view_type());
+    }
+
+    void ReplaceAll(string_type& str, view_type find, view_type replace)
+    {
+        journal_type* journal = Journal();
+        std::vector<size_t> positions = ReplacePositions(journal, str, find);
+
+        ReplaceSet<T>::ReplaceAllIn(str, find, replace);
+        RecordReplace(journal, positions, find, replace);
+    }
+
+    void AppendRecorded(string_type& str, view_type operand)
+    {
+        size_t offset = str.length();
+
+        str.append(operand);
+        RecordEdit(Journal(), offset, 0, view_type(str).substr(offset));
+    }
+
+    journal_type* Journal() const
+    {
+        return journaled.load(std::memory_order_relaxed) ? journal_type::Find(this) : nullptr;
+    }
+
+    void RecordEdit(journal_type* journal, size_t offset, size_t erased, view_type inserted)
+    {
+        if (journal != nullptr)
+            journal->Record(version.load(std::memory_order_relaxed), offset, erased, inserted);
+    }
+
+    static std::vector<size_t> ReplacePositions(journal_type* journal, const string_type& str, view_type find)
+    {
+        if (journal == nullptr || find.empty())
+            return {};
+
+        return Searcher<T>(find).FindAll(str);
+    }
+
+    void RecordReplace(journal_type* journal, const std::vector<size_t>& positions, view_type find, view_type replace)
+    {
+        size_t shift = 0;
+
+        for (size_t position : positions)
+        {
+            RecordEdit(journal, position + shift, find.length(), replace);
+            shift += replace.length() - find.length();
+        }
+    }
+
+    template <typename U, typename P, typename A>
+    string_type Converted(const AtomicString<U, P, A>& from) const
+    {
+        return from.Read([this, &from](const typename AtomicString<U, P, A>::string_type& str)
+        {
+            ATOMICBASE_RECORD_BYTES(from.mutex, str.length() * sizeof(U));
+            return Converted<U>(str);
+        });
+    }
+
+    template <typename U>
+    string_type Converted(std::basic_string_view<U> from) const
+    {
+        return Converted<U>(from, data.get_allocator());
+    }
+
+    template <typename U>
+    static string_type Converted(std::basic_string_view<U> from, const allocator_type& allocator)
+    {
+        if constexpr (std::is_same<U, T>::value)
+            return string_type(from, allocator);
         else
         {
-            std::cout << std::format("Unsupported character conversion. Conversion between '{}' and '{}'.", typeid(F).name(), typeid(L).name()) << std::endl;
-            throw std::runtime_error("Unsupported character conversion.");
+            string_type result(Transcoder::Measure<U, T>(from.data(), from.length()), T(), allocator);
+
+            Transcoder::Write<U, T>(from.data(), from.length(), result.data());
+
+            return result;
         }
     }
 
-    template <typename T>
-	friend std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicString<T>& str);
+    template <typename F, typename L>
+    static std::basic_string<L> Convert(std::basic_string_view<F> from)
+    {
+        if constexpr (std::is_same<F, L>::value)
+            return std::basic_string<L>(from);
+        else
+            return Transcoder::Convert<F, L>(from);
+    }
+
+    template <typename F, typename L, typename A = std::allocator<L>>
+    static std::basic_string<L, std::char_traits<L>, A> ConvertParallel(std::basic_string_view<F> from, ThreadPool& pool, const A& allocator = A())
+    {
+        if constexpr (std::is_same<F, L>::value)
+            return std::basic_string<L, std::char_traits<L>, A>(from, allocator);
+        else
+            return ParallelTransform::Convert<F, L>(from, pool, allocator);
+    }
 
-	template <typename T1, typename T2>
-	friend auto operator+(const AtomicString<T1>& lhs, const AtomicString<T2>& rhs);
+    template <typename, typename, typename>
+    friend class AtomicString;
 
-	template <typename T1, typename T2>
-	friend auto operator-(const AtomicString<T1>& lhs, const AtomicString<T2>& rhs);
+    template <typename U, typename P, typename A>
+	friend std::basic_ostream<U>& operator<<(std::basic_ostream<U>& stream, const AtomicString<U, P, A>& str);
 
-    mutable std::shared_mutex mutex;
-    std::shared_ptr<std::mutex> iteratorMutex = std::make_shared<std::mutex>();
+    mutable mutex_type mutex;
+    mutable std::atomic<std::uint32_t> waiters = 0;
+    mutable std::atomic<std::uint32_t> changes = 0;
+    std::atomic<bool> hashCacheable = true;
+    std::atomic<bool> journaled = false;
 
-    std::basic_string<T> data;
+    std::atomic<std::uint64_t> version = 0;
+    mutable std::atomic<size_t> cachedHash = 0;
+
+    string_type data;
+
+#if defined(ATOMICBASE_INSTRUMENTATION)
+    std::shared_ptr<LockStatistics> statistics;
+#endif
 
 };
 
-template <typename T>
-std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicString<T>& str)
+template <typename T, typename LockPolicy, typename Allocator>
+std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicString<T, LockPolicy, Allocator>& str)
 {
     static_assert(
         std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
@@ -688,15 +1897,16 @@ std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const AtomicStr
         "T only supports char, wchar_t, char16_t, and char32_t types."
         );
 
-    std::shared_lock<std::shared_mutex> lock(str.mutex);
+    typename AtomicString<T, LockPolicy, Allocator>::string_type snapshot(str.GetAllocator());
 
-    stream << str.data;
+    str.AppendTo(snapshot);
+    stream << snapshot;
 
     return stream;
 }
 
-template <typename T1, typename T2>
-auto operator+(const AtomicString<T1>& lhs, const AtomicString<T2>& rhs)
+template <typename T1, typename P1, typename A1, typename T2, typename P2, typename A2>
+auto operator+(const AtomicString<T1, P1, A1>& lhs, const AtomicString<T2, P2, A2>& rhs)
 {
     static_assert(
         std::is_same<T1, char>::value || std::is_same<T1, wchar_t>::value ||
@@ -711,21 +1921,18 @@ auto operator+(const AtomicString<T1>& lhs, const AtomicString<T2>& rhs)
         );
 
     using ReturnType = std::conditional_t<std::is_same_v<T1, wchar_t> || std::is_same_v<T2, wchar_t>, wchar_t, char>;
+    using allocator_type = typename std::allocator_traits<A1>::template rebind_alloc<ReturnType>;
 
-    AtomicString<ReturnType> lhsConverted = lhs.operator std::basic_string<ReturnType>();
-    AtomicString<ReturnType> rhsConverted = rhs.operator std::basic_string<ReturnType>();
-
-    std::scoped_lock lock(lhsConverted.mutex, rhsConverted.mutex);
+    std::basic_string<ReturnType, std::char_traits<ReturnType>, allocator_type> result(lhs.GetAllocator());
 
-    AtomicString<ReturnType> result;
+    lhs.AppendTo(result);
+    rhs.AppendTo(result);
 
-    result.data = lhsConverted.data + rhsConverted.data;
-
-    return result;
+    return AtomicString<ReturnType, P1, allocator_type>(std::move(result));
 }
 
-template <typename T1, typename T2>
-auto operator-(const AtomicString<T1>& lhs, const AtomicString<T2>& rhs)
+template <typename T1, typename P1, typename A1, typename T2, typename P2, typename A2>
+auto operator-(const AtomicString<T1, P1, A1>& lhs, const AtomicString<T2, P2, A2>& rhs)
 {
     static_assert(
         std::is_same<T1, char>::value || std::is_same<T1, wchar_t>::value ||
@@ -740,18 +1947,31 @@ auto operator-(const AtomicString<T1>& lhs, const AtomicString<T2>& rhs)
         );
 
     using ReturnType = std::conditional_t<std::is_same_v<T1, wchar_t> || std::is_same_v<T2, wchar_t>, wchar_t, char>;
+    using allocator_type = typename std::allocator_traits<A1>::template rebind_alloc<ReturnType>;
+
+    allocator_type allocator(lhs.GetAllocator());
 
-    AtomicString<ReturnType> lhsConverted = lhs.operator std::basic_string<ReturnType>();
-    AtomicString<ReturnType> rhsConverted = rhs.operator std::basic_string<ReturnType>();
+    std::basic_string<ReturnType, std::char_traits<ReturnType>, allocator_type> source(allocator);
+    std::basic_string<ReturnType, std::char_traits<ReturnType>, allocator_type> pattern(allocator);
 
-    std::scoped_lock lock(lhsConverted.mutex, rhsConverted.mutex);
+    lhs.AppendTo(source);
+    rhs.AppendTo(pattern);
 
-    AtomicString<ReturnType> result = lhsConverted;
+    return AtomicString<ReturnType, P1, allocator_type>(ReplaceSet<ReturnType>::ReplaceAll(source, pattern, {}, allocator));
+}
 
-    size_t pos = 0;
+template <typename T, typename LockPolicy = SharedMutexLockPolicy>
+using PmrAtomicString = AtomicString<T, LockPolicy, std::pmr::polymorphic_allocator<T>>;
 
-    while ((pos = result.data.find(rhsConverted.data, pos)) != std::basic_string<ReturnType>::npos)
-        result.data.erase(pos, rhsConverted.data.length());
+#if !defined(ATOMICBASE_INSTRUMENTATION)
+static_assert(sizeof(std::string) > 32 || sizeof(AtomicString<char, CompactLockPolicy>) <= 64, "AtomicString<char, CompactLockPolicy> must fit in one cache line.");
+#endif
 
-    return result;
-}
\ No newline at end of file
+template <typename T, typename LockPolicy, typename Allocator>
+struct std::hash<AtomicString<T, LockPolicy, Allocator>>
+{
+    size_t operator()(const AtomicString<T, LockPolicy, Allocator>& str) const
+    {
+        return str.Hash();
+    }
+};
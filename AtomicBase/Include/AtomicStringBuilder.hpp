@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "LockPolicy.hpp"
+#include "AtomicString.hpp"
+
+template <typename T, typename LockPolicy = SharedMutexLockPolicy, typename Allocator = std::allocator<T>>
+class AtomicStringBuilder
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+public:
+
+    using allocator_type = Allocator;
+    using string_type = std::basic_string<T, std::char_traits<T>, Allocator>;
+    using view_type = std::basic_string_view<T>;
+    using result_type = AtomicString<T, LockPolicy, Allocator>;
+
+    static constexpr size_t DefaultCapacity = 4096;
+    static constexpr size_t MaxSegments = 40;
+
+    explicit AtomicStringBuilder(size_t capacity = DefaultCapacity, const allocator_type& allocator = allocator_type()) : allocator(allocator), capacity(std::max<size_t>(capacity, 1)), head(this->capacity, T(), allocator) {}
+
+    AtomicStringBuilder(const AtomicStringBuilder&) = delete;
+    AtomicStringBuilder& operator=(const AtomicStringBuilder&) = delete;
+
+    ~AtomicStringBuilder()
+    {
+        Release();
+    }
+
+    size_t Append(view_type str)
+    {
+        size_t offset = reserved.fetch_add(str.length(), std::memory_order_relaxed);
+
+        if ((offset & SealedBit) != 0)
+            throw std::runtime_error("Cannot append to a sealed builder.");
+
+        if (str.empty())
+            return offset;
+
+        try
+        {
+            if (offset + str.length() > MaxLength())
+                throw std::runtime_error("Builder capacity exceeded.");
+
+            for (size_t written = 0; written < str.length(); )
+            {
+                size_t position = offset + written;
+                size_t segment = SegmentOf(position);
+                size_t index = position - SegmentStart(segment);
+                size_t count = std::min(str.length() - written, SegmentLength(segment) - index);
+
+                std::copy(str.data() + written, str.data() + written + count, Segment(segment) + index);
+
+                written += count;
+            }
+        }
+        catch (...)
+        {
+            failed.store(true, std::memory_order_relaxed);
+            committed.fetch_add(str.length(), std::memory_order_release);
+            throw;
+        }
+
+        committed.fetch_add(str.length(), std::memory_order_release);
+
+        return offset;
+    }
+
+    size_t Append(const T* str)
+    {
+        return Append(view_type(str));
+    }
+
+    AtomicStringBuilder& operator+=(view_type str)
+    {
+        Append(str);
+
+        return *this;
+    }
+
+    AtomicStringBuilder& operator+=(const T* str)
+    {
+        Append(view_type(str));
+
+        return *this;
+    }
+
+    size_t Length() const
+    {
+        return committed.load(std::memory_order_acquire);
+    }
+
+    bool Sealed() const
+    {
+        return (reserved.load(std::memory_order_acquire) & SealedBit) != 0;
+    }
+
+    string_type Seal()
+    {
+        size_t total = reserved.fetch_or(SealedBit, std::memory_order_acq_rel);
+
+        if ((total & SealedBit) != 0)
+            throw std::runtime_error("Builder is already sealed.");
+
+        SpinBackoff backoff;
+
+        while (committed.load(std::memory_order_acquire) != total)
+            backoff.Pause();
+
+        // A reservation whose copy threw leaves a gap of unwritten characters,
+        // so the partial result is discarded rather than returned.
+        if (failed.load(std::memory_order_relaxed))
+        {
+            Release();
+            throw std::runtime_error("Builder holds a failed append.");
+        }
+
+        string_type result = std::move(head);
+
+        if (total <= capacity)
+            result.resize(total);
+        else
+        {
+            result.reserve(total);
+
+            for (size_t segment = 1; result.length() < total; ++segment)
+                result.append(Segment(segment), std::min(SegmentLength(segment), total - result.length()));
+        }
+
+        Release();
+
+        return result;
+    }
+
+    result_type ToAtomicString()
+    {
+        return result_type(Seal());
+    }
+
+private:
+
+    static constexpr size_t SealedBit = size_t(1) << (std::numeric_limits<size_t>::digits - 1);
+
+    using traits_type = std::allocator_traits<Allocator>;
+
+    size_t MaxLength() const
+    {
+        return capacity > (SealedBit >> MaxSegments) ? SealedBit - 1 : SegmentStart(MaxSegments);
+    }
+
+    size_t SegmentOf(size_t position) const
+    {
+        return std::bit_width(position / capacity + 1) - 1;
+    }
+
+    size_t SegmentStart(size_t segment) const
+    {
+        return capacity * ((size_t(1) << segment) - 1);
+    }
+
+    size_t SegmentLength(size_t segment) const
+    {
+        return capacity << segment;
+    }
+
+    T* Segment(size_t segment)
+    {
+        if (segment == 0)
+            return head.data();
+
+        std::atomic<T*>& slot = segments[segment];
+        T* current = slot.load(std::memory_order_acquire);
+
+        if (current != nullptr)
+            return current;
+
+        T* fresh = traits_type::allocate(allocator, SegmentLength(segment));
+
+        if (slot.compare_exchange_strong(current, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+            return fresh;
+
+        traits_type::deallocate(allocator, fresh, SegmentLength(segment));
+
+        return current;
+    }
+
+    void Release()
+    {
+        for (size_t segment = 1; segment < MaxSegments; ++segment)
+        {
+            if (T* storage = segments[segment].exchange(nullptr, std::memory_order_acq_rel))
+                traits_type::deallocate(allocator, storage, SegmentLength(segment));
+        }
+    }
+
+    allocator_type allocator;
+    size_t capacity;
+    string_type head;
+    std::atomic<T*> segments[MaxSegments] = {};
+
+    alignas(64) std::atomic<size_t> reserved = 0;
+    alignas(64) std::atomic<size_t> committed = 0;
+    std::atomic<bool> failed = false;
+
+};
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include <cctype>
+#include <cwctype>
+#include <cwchar>
+#include <cstdint>
+#include "SimdSupport.hpp"
+
+class CaseConversion
+{
+
+public:
+
+    template <typename T>
+    static void ToUpper(T* data, size_t length)
+    {
+        Transform<true>(data, length);
+    }
+
+    template <typename T>
+    static void ToLower(T* data, size_t length)
+    {
+        Transform<false>(data, length);
+    }
+
+    template <typename T>
+    static bool EqualsIgnoreCase(std::basic_string_view<T> lhs, std::basic_string_view<T> rhs)
+    {
+        return lhs.length() == rhs.length() && Mismatch(lhs.data(), rhs.data(), lhs.length()) == lhs.length();
+    }
+
+    template <typename T>
+    static int CompareIgnoreCase(std::basic_string_view<T> lhs, std::basic_string_view<T> rhs)
+    {
+        size_t length = std::min(lhs.length(), rhs.length());
+        size_t index = Mismatch(lhs.data(), rhs.data(), length);
+
+        if (index == length)
+            return lhs.length() < rhs.length() ? -1 : (lhs.length() > rhs.length() ? 1 : 0);
+
+        std::uint32_t left = Unit(Map<false>(lhs[index]));
+        std::uint32_t right = Unit(Map<false>(rhs[index]));
+
+        return left < right ? -1 : 1;
+    }
+
+    template <bool Upper, typename T>
+    static T Map(T c)
+    {
+        std::uint32_t unit = Unit(c);
+
+        if (unit < 0x80)
+        {
+            if (Upper && unit >= 'a' && unit <= 'z')
+                return static_cast<T>(unit - 0x20);
+
+            if (!Upper && unit >= 'A' && unit <= 'Z')
+                return static_cast<T>(unit + 0x20);
+
+            return c;
+        }
+
+        if constexpr (std::is_same<T, char>::value)
+            return static_cast<T>(Upper ? ::toupper(static_cast<int>(unit)) : ::tolower(static_cast<int>(unit)));
+        else
+        {
+            if ((unit >= 0xD800 && unit <= 0xDFFF) || unit > static_cast<std::uint32_t>(WINT_MAX))
+                return c;
+
+            return static_cast<T>(Upper ? std::towupper(static_cast<std::wint_t>(unit)) : std::towlower(static_cast<std::wint_t>(unit)));
+        }
+    }
+
+private:
+
+    template <typename T>
+    static std::uint32_t Unit(T c)
+    {
+        return static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<T>>(c));
+    }
+
+    template <bool Upper, typename T>
+    static void Transform(T* data, size_t length)
+    {
+        size_t done = 0;
+
+#if defined(ATOMICBASE_SSE2)
+        if (CpuFeatures::HasAvx2())
+            done = TransformAvx2<Upper>(data, length);
+        else
+            done = TransformSse2<Upper>(data, length);
+#endif
+
+        for (size_t i = done; i < length; ++i)
+            data[i] = Map<Upper>(data[i]);
+    }
+
+    template <typename T>
+    static size_t Mismatch(const T* lhs, const T* rhs, size_t length)
+    {
+        size_t done = 0;
+
+#if defined(ATOMICBASE_SSE2)
+        size_t found;
+
+        if (CpuFeatures::HasAvx2())
+            found = MismatchAvx2(lhs, rhs, length, done);
+        else
+            found = MismatchSse2(lhs, rhs, length, done);
+
+        if (found != length)
+            return found;
+#endif
+
+        for (size_t i = done; i < length; ++i)
+        {
+            if (Map<false>(lhs[i]) != Map<false>(rhs[i]))
+                return i;
+        }
+
+        return length;
+    }
+
+#if defined(ATOMICBASE_SSE2)
+
+    template <typename T>
+    static __m128i Splat(std::uint32_t value)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm_set1_epi8(static_cast<char>(value));
+        else if constexpr (sizeof(T) == 2)
+            return _mm_set1_epi16(static_cast<short>(value));
+        else
+            return _mm_set1_epi32(static_cast<int>(value));
+    }
+
+    template <typename T>
+    static __m128i GreaterThan(__m128i lhs, __m128i rhs)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm_cmpgt_epi8(lhs, rhs);
+        else if constexpr (sizeof(T) == 2)
+            return _mm_cmpgt_epi16(lhs, rhs);
+        else
+            return _mm_cmpgt_epi32(lhs, rhs);
+    }
+
+    template <typename T>
+    static bool IsAscii(__m128i block)
+    {
+        __m128i high = _mm_and_si128(block, Splat<T>(~0x7Fu));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(high, _mm_setzero_si128())) == 0xFFFF;
+    }
+
+    template <bool Upper, typename T>
+    static __m128i FlipCase(__m128i block)
+    {
+        __m128i first = Splat<T>(Upper ? 'a' - 1 : 'A' - 1);
+        __m128i last = Splat<T>(Upper ? 'z' + 1 : 'Z' + 1);
+        __m128i inRange = _mm_and_si128(GreaterThan<T>(block, first), GreaterThan<T>(last, block));
+
+        return _mm_xor_si128(block, _mm_and_si128(inRange, Splat<T>(0x20)));
+    }
+
+    template <bool Upper, typename T>
+    static size_t TransformSse2(T* data, size_t length)
+    {
+        constexpr size_t Lanes = sizeof(__m128i) / sizeof(T);
+
+        size_t i = 0;
+
+        for (; i + Lanes <= length; i += Lanes)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+
+            if (!IsAscii<T>(block))
+            {
+                for (size_t j = i; j < i + Lanes; ++j)
+                    data[j] = Map<Upper>(data[j]);
+
+                continue;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), FlipCase<Upper, T>(block));
+        }
+
+        return i;
+    }
+
+    template <typename T>
+    static size_t MismatchSse2(const T* lhs, const T* rhs, size_t length, size_t& done)
+    {
+        constexpr size_t Lanes = sizeof(__m128i) / sizeof(T);
+
+        size_t i = 0;
+
+        for (; i + Lanes <= length; i += Lanes)
+        {
+            __m128i left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+            __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+
+            if (!IsAscii<T>(_mm_or_si128(left, right)))
+            {
+                for (size_t j = i; j < i + Lanes; ++j)
+                {
+                    if (Map<false>(lhs[j]) != Map<false>(rhs[j]))
+                        return j;
+                }
+
+                continue;
+            }
+
+            unsigned equal = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(FlipCase<false, T>(left), FlipCase<false, T>(right))));
+
+            if (equal != 0xFFFF)
+                return i + CpuFeatures::CountTrailingZeros(~equal) / sizeof(T);
+        }
+
+        done = i;
+
+        return length;
+    }
+
+    template <typename T>
+    ATOMICBASE_TARGET_AVX2 static __m256i Splat256(std::uint32_t value)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm256_set1_epi8(static_cast<char>(value));
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_set1_epi16(static_cast<short>(value));
+        else
+            return _mm256_set1_epi32(static_cast<int>(value));
+    }
+
+    template <typename T>
+    ATOMICBASE_TARGET_AVX2 static __m256i GreaterThan256(__m256i lhs, __m256i rhs)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm256_cmpgt_epi8(lhs, rhs);
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_cmpgt_epi16(lhs, rhs);
+        else
+            return _mm256_cmpgt_epi32(lhs, rhs);
+    }
+
+    template <typename T>
+    ATOMICBASE_TARGET_AVX2 static bool IsAscii256(__m256i block)
+    {
+        return _mm256_testz_si256(block, Splat256<T>(~0x7Fu)) != 0;
+    }
+
+    template <bool Upper, typename T>
+    ATOMICBASE_TARGET_AVX2 static __m256i FlipCase256(__m256i block)
+    {
+        __m256i first = Splat256<T>(Upper ? 'a' - 1 : 'A' - 1);
+        __m256i last = Splat256<T>(Upper ? 'z' + 1 : 'Z' + 1);
+        __m256i inRange = _mm256_and_si256(GreaterThan256<T>(block, first), GreaterThan256<T>(last, block));
+
+        return _mm256_xor_si256(block, _mm256_and_si256(inRange, Splat256<T>(0x20)));
+    }
+
+    template <bool Upper, typename T>
+    ATOMICBASE_TARGET_AVX2 static size_t TransformAvx2(T* data, size_t length)
+    {
+        constexpr size_t Lanes = sizeof(__m256i) / sizeof(T);
+
+        size_t i = 0;
+
+        for (; i + Lanes <= length; i += Lanes)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+
+            if (!IsAscii256<T>(block))
+            {
+                for (size_t j = i; j < i + Lanes; ++j)
+                    data[j] = Map<Upper>(data[j]);
+
+                continue;
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), FlipCase256<Upper, T>(block));
+        }
+
+        return i;
+    }
+
+    template <typename T>
+    ATOMICBASE_TARGET_AVX2 static size_t MismatchAvx2(const T* lhs, const T* rhs, size_t length, size_t& done)
+    {
+        constexpr size_t Lanes = sizeof(__m256i) / sizeof(T);
+
+        size_t i = 0;
+
+        for (; i + Lanes <= length; i += Lanes)
+        {
+            __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+            __m256i right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+
+            if (!IsAscii256<T>(_mm256_or_si256(left, right)))
+            {
+                for (size_t j = i; j < i + Lanes; ++j)
+                {
+                    if (Map<false>(lhs[j]) != Map<false>(rhs[j]))
+                        return j;
+                }
+
+                continue;
+            }
+
+            unsigned equal = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(FlipCase256<false, T>(left), FlipCase256<false, T>(right))));
+
+            if (equal != 0xFFFFFFFFu)
+                return i + CpuFeatures::CountTrailingZeros(~equal) / sizeof(T);
+        }
+
+        done = i;
+
+        return length;
+    }
+
+#endif
+
+};
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <limits>
+#include <functional>
+#include <type_traits>
+#include "AtomicString.hpp"
+#include "InternedString.hpp"
+
+template <typename T>
+struct AtomicStringHash
+{
+    using is_transparent = void;
+    using view_type = std::basic_string_view<T>;
+
+    size_t operator()(view_type str) const
+    {
+        return std::hash<view_type>{}(str);
+    }
+
+    size_t operator()(const std::basic_string<T>& str) const
+    {
+        return std::hash<view_type>{}(str);
+    }
+
+    size_t operator()(const T* str) const
+    {
+        return std::hash<view_type>{}(str);
+    }
+
+    size_t operator()(const InternedString<T>& str) const
+    {
+        return str.Hash();
+    }
+
+    template <typename P, typename A>
+    size_t operator()(const AtomicString<T, P, A>& str) const
+    {
+        return str.Hash();
+    }
+};
+
+template <typename T>
+struct AtomicStringEqual
+{
+    using is_transparent = void;
+    using view_type = std::basic_string_view<T>;
+
+    bool operator()(view_type lhs, view_type rhs) const
+    {
+        return lhs == rhs;
+    }
+
+    template <typename P, typename A>
+    bool operator()(const AtomicString<T, P, A>& lhs, view_type rhs) const
+    {
+        return lhs.Read([rhs](const typename AtomicString<T, P, A>::string_type& str) { return view_type(str) == rhs; });
+    }
+
+    template <typename P, typename A>
+    bool operator()(view_type lhs, const AtomicString<T, P, A>& rhs) const
+    {
+        return (*this)(rhs, lhs);
+    }
+
+    template <typename P1, typename A1, typename P2, typename A2>
+    bool operator()(const AtomicString<T, P1, A1>& lhs, const AtomicString<T, P2, A2>& rhs) const
+    {
+        return lhs == rhs;
+    }
+};
+
+template <typename T, typename V>
+class ConcurrentStringMap
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+    using mapped_type = V;
+
+    static constexpr size_t ShardBits = 6;
+    static constexpr size_t ShardCount = size_t(1) << ShardBits;
+    static constexpr size_t MinCapacity = 16;
+
+    ConcurrentStringMap() = default;
+
+    ConcurrentStringMap(const ConcurrentStringMap&) = delete;
+    ConcurrentStringMap& operator=(const ConcurrentStringMap&) = delete;
+
+    template <typename K>
+    bool Insert(const K& key, V value)
+    {
+        return WithKey(key, [this, &value](view_type str, size_t hash) { return Emplace(str, hash, std::move(value), false); });
+    }
+
+    template <typename K>
+    bool InsertOrAssign(const K& key, V value)
+    {
+        return WithKey(key, [this, &value](view_type str, size_t hash) { return Emplace(str, hash, std::move(value), true); });
+    }
+
+    template <typename K>
+    std::optional<V> Find(const K& key) const
+    {
+        return WithKey(key, [this](view_type str, size_t hash)
+        {
+            const Shard& shard = ShardOf(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+            size_t slot = Locate(shard, str, hash);
+
+            return slot == npos ? std::optional<V>() : std::optional<V>(shard.entries[slot]->value);
+        });
+    }
+
+    template <typename K, typename F>
+    bool Visit(const K& key, F&& function) const
+    {
+        return WithKey(key, [this, &function](view_type str, size_t hash)
+        {
+            const Shard& shard = ShardOf(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+            size_t slot = Locate(shard, str, hash);
+
+            if (slot == npos)
+                return false;
+
+            function(static_cast<const V&>(shard.entries[slot]->value));
+
+            return true;
+        });
+    }
+
+    template <typename K, typename F>
+    bool Update(const K& key, F&& function)
+    {
+        return WithKey(key, [this, &function](view_type str, size_t hash)
+        {
+            Shard& shard = ShardOf(hash);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            size_t slot = Locate(shard, str, hash);
+
+            if (slot == npos)
+                return false;
+
+            function(shard.entries[slot]->value);
+
+            return true;
+        });
+    }
+
+    template <typename K>
+    bool Contains(const K& key) const
+    {
+        return WithKey(key, [this](view_type str, size_t hash)
+        {
+            const Shard& shard = ShardOf(hash);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+            return Locate(shard, str, hash) != npos;
+        });
+    }
+
+    template <typename K>
+    bool Erase(const K& key)
+    {
+        return WithKey(key, [this](view_type str, size_t hash)
+        {
+            Shard& shard = ShardOf(hash);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            size_t slot = Locate(shard, str, hash);
+
+            if (slot == npos)
+                return false;
+
+            shard.tags[slot] = Tombstone;
+            shard.entries[slot].reset();
+
+            --shard.count;
+            ++shard.tombstones;
+
+            return true;
+        });
+    }
+
+    size_t Size() const
+    {
+        size_t size = 0;
+
+        for (const Shard& shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            size += shard.count;
+        }
+
+        return size;
+    }
+
+    void Clear()
+    {
+        for (Shard& shard : shards)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            shard.tags.clear();
+            shard.entries.clear();
+            shard.count = 0;
+            shard.tombstones = 0;
+        }
+    }
+
+private:
+
+    static constexpr size_t npos = ~size_t(0);
+    static constexpr size_t Empty = 0;
+    static constexpr size_t Tombstone = 1;
+
+    struct Entry
+    {
+        string_type key;
+        V value;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::vector<size_t> tags;
+        std::vector<std::optional<Entry>> entries;
+        size_t count = 0;
+        size_t tombstones = 0;
+    };
+
+    template <typename F>
+    static auto WithKey(view_type key, F&& function)
+    {
+        return function(key, std::hash<view_type>{}(key));
+    }
+
+    template <typename F>
+    static auto WithKey(const InternedString<T>& key, F&& function)
+    {
+        return function(key.View(), key.Hash());
+    }
+
+    template <typename P, typename A, typename F>
+    static auto WithKey(const AtomicString<T, P, A>& key, F&& function)
+    {
+        return key.ReadHashed([&function](const typename AtomicString<T, P, A>::string_type& str, size_t hash) { return function(view_type(str), hash); });
+    }
+
+    static size_t TagOf(size_t hash)
+    {
+        return hash <= Tombstone ? hash + 2 : hash;
+    }
+
+    Shard& ShardOf(size_t hash)
+    {
+        return shards[TagOf(hash) >> (std::numeric_limits<size_t>::digits - ShardBits)];
+    }
+
+    const Shard& ShardOf(size_t hash) const
+    {
+        return shards[TagOf(hash) >> (std::numeric_limits<size_t>::digits - ShardBits)];
+    }
+
+    static size_t Locate(const Shard& shard, view_type key, size_t hash)
+    {
+        if (shard.tags.empty())
+            return npos;
+
+        size_t tag = TagOf(hash);
+        size_t mask = shard.tags.size() - 1;
+
+        for (size_t i = tag & mask, probes = 0; probes < shard.tags.size(); i = (i + 1) & mask, ++probes)
+        {
+            if (shard.tags[i] == Empty)
+                return npos;
+
+            if (shard.tags[i] == tag && shard.entries[i]->key == key)
+                return i;
+        }
+
+        return npos;
+    }
+
+    static void Place(Shard& shard, size_t tag, std::optional<Entry>&& entry)
+    {
+        size_t mask = shard.tags.size() - 1;
+        size_t i = tag & mask;
+
+        while (shard.tags[i] != Empty && shard.tags[i] != Tombstone)
+            i = (i + 1) & mask;
+
+        if (shard.tags[i] == Tombstone)
+            --shard.tombstones;
+
+        shard.tags[i] = tag;
+        shard.entries[i] = std::move(entry);
+    }
+
+    static void Rehash(Shard& shard, size_t capacity)
+    {
+        std::vector<size_t> tags(capacity, Empty);
+        std::vector<std::optional<Entry>> entries(capacity);
+
+        tags.swap(shard.tags);
+        entries.swap(shard.entries);
+        shard.tombstones = 0;
+
+        for (size_t i = 0; i < tags.size(); ++i)
+        {
+            if (tags[i] != Empty && tags[i] != Tombstone)
+                Place(shard, tags[i], std::move(entries[i]));
+        }
+    }
+
+    bool Emplace(view_type key, size_t hash, V&& value, bool assign)
+    {
+        Shard& shard = ShardOf(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        size_t slot = Locate(shard, key, hash);
+
+        if (slot != npos)
+        {
+            if (assign)
+                shard.entries[slot]->value = std::move(value);
+
+            return false;
+        }
+
+        if ((shard.count + shard.tombstones + 1) * 4 > shard.tags.size() * 3)
+        {
+            size_t capacity = MinCapacity;
+
+            while (capacity < (shard.count + 1) * 2)
+                capacity *= 2;
+
+            Rehash(shard, capacity);
+        }
+
+        Place(shard, TagOf(hash), std::optional<Entry>(Entry{ string_type(key), std::move(value) }));
+        ++shard.count;
+
+        return true;
+    }
+
+    Shard shards[ShardCount];
+
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+class EditJournal
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+
+    static constexpr size_t Unlimited = std::numeric_limits<size_t>::max();
+
+    struct Options
+    {
+        size_t maxDeltas = 4096;
+        size_t maxBytes = 1 << 20;
+    };
+
+    struct Delta
+    {
+        std::uint64_t version = 0;
+        size_t offset = 0;
+        size_t erased = 0;
+        string_type inserted;
+    };
+
+    struct Batch
+    {
+        std::uint64_t from = 0;
+        std::uint64_t to = 0;
+        bool snapshot = false;
+        string_type contents;
+        std::vector<Delta> deltas;
+    };
+
+    EditJournal(std::uint64_t version, Options options) : options(options), base(version), head(version) {}
+
+    static EditJournal* Attach(const void* owner, std::uint64_t version, Options options)
+    {
+        Registry& registry = Journals();
+        std::unique_lock<std::shared_mutex> lock(registry.mutex);
+
+        std::unique_ptr<EditJournal>& journal = registry.journals[owner];
+        journal = std::make_unique<EditJournal>(version, options);
+
+        return journal.get();
+    }
+
+    static EditJournal* Find(const void* owner)
+    {
+        Registry& registry = Journals();
+        std::shared_lock<std::shared_mutex> lock(registry.mutex);
+
+        auto found = registry.journals.find(owner);
+
+        return found != registry.journals.end() ? found->second.get() : nullptr;
+    }
+
+    static void Detach(const void* owner)
+    {
+        Registry& registry = Journals();
+        std::unique_lock<std::shared_mutex> lock(registry.mutex);
+
+        registry.journals.erase(owner);
+    }
+
+    void Record(std::uint64_t version, size_t offset, size_t erased, view_type inserted)
+    {
+        bool tainted = stale.exchange(false, std::memory_order_acquire);
+
+        if (tainted || head == Invalidated || (version != head && version != head + 1))
+        {
+            deltas.clear();
+            bytes = 0;
+            base = tainted ? version : version - 1;
+        }
+
+        head = version;
+        deltas.push_back({ version, offset, erased, string_type(inserted) });
+        bytes += sizeof(Delta) + inserted.length() * sizeof(T);
+
+        Compact();
+    }
+
+    void Invalidate()
+    {
+        deltas.clear();
+        bytes = 0;
+        head = Invalidated;
+    }
+
+    // The contents may change in place without a new version, so not even the
+    // current version can be replayed from until the next recorded edit. Safe
+    // to call under the owner's shared lock.
+    void Taint()
+    {
+        stale.store(true, std::memory_order_release);
+    }
+
+    bool Collect(std::uint64_t since, std::uint64_t current, size_t limit, size_t budget, Batch& batch) const
+    {
+        if (stale.load(std::memory_order_acquire) || current != head || since < base || since > current)
+            return false;
+
+        batch.from = since;
+        batch.to = since;
+
+        auto next = std::upper_bound(deltas.begin(), deltas.end(), since, [](std::uint64_t version, const Delta& delta) { return version < delta.version; });
+        size_t spent = 0;
+
+        while (next != deltas.end() && (batch.deltas.empty() || batch.deltas.size() < limit))
+        {
+            std::uint64_t version = next->version;
+
+            for (; next != deltas.end() && next->version == version; ++next)
+            {
+                spent += next->inserted.length();
+
+                if (spent > budget)
+                    return false;
+
+                batch.deltas.push_back(*next);
+            }
+
+            batch.to = version;
+        }
+
+        return true;
+    }
+
+    std::uint64_t Oldest() const
+    {
+        return base;
+    }
+
+    size_t Bytes() const
+    {
+        return bytes;
+    }
+
+    static void Apply(string_type& replica, const Delta& delta)
+    {
+        if (delta.offset > replica.length() || delta.erased > replica.length() - delta.offset)
+            throw std::runtime_error("Delta does not apply to this replica.");
+
+        replica.replace(delta.offset, delta.erased, delta.inserted);
+    }
+
+    static std::uint64_t Apply(string_type& replica, const Batch& batch)
+    {
+        if (batch.snapshot)
+            replica = batch.contents;
+        else
+        {
+            for (const Delta& delta : batch.deltas)
+                Apply(replica, delta);
+        }
+
+        return batch.to;
+    }
+
+private:
+
+    struct Registry
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<const void*, std::unique_ptr<EditJournal>> journals;
+    };
+
+    static constexpr std::uint64_t Invalidated = std::numeric_limits<std::uint64_t>::max();
+
+    static Registry& Journals()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    void Compact()
+    {
+        while (!deltas.empty() && (deltas.size() > options.maxDeltas || bytes > options.maxBytes))
+        {
+            std::uint64_t version = deltas.front().version;
+
+            while (!deltas.empty() && deltas.front().version == version)
+            {
+                bytes -= sizeof(Delta) + deltas.front().inserted.length() * sizeof(T);
+                deltas.pop_front();
+            }
+
+            base = version;
+        }
+    }
+
+    Options options;
+    std::uint64_t base;
+    std::uint64_t head;
+    size_t bytes = 0;
+    std::deque<Delta> deltas;
+    std::atomic<bool> stale = false;
+
+};
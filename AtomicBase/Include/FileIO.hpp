@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <climits>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class FileIO
+{
+
+public:
+
+    static constexpr size_t DefaultChunkSize = 64 * 1024;
+    static constexpr size_t Unlimited = static_cast<size_t>(-1);
+
+    class Descriptor
+    {
+
+    public:
+
+        explicit Descriptor(const std::filesystem::path& path)
+        {
+#if defined(_WIN32)
+            handle = _wopen(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+            do
+                handle = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            while (handle < 0 && errno == EINTR);
+#endif
+
+            if (handle < 0)
+                throw std::runtime_error("Failed to open " + path.string() + ".");
+        }
+
+        Descriptor(const Descriptor&) = delete;
+        Descriptor& operator=(const Descriptor&) = delete;
+
+        ~Descriptor()
+        {
+#if defined(_WIN32)
+            _close(handle);
+#else
+            close(handle);
+#endif
+        }
+
+        int Get() const
+        {
+            return handle;
+        }
+
+    private:
+
+        int handle = -1;
+
+    };
+
+    static size_t SizeHint(int fd)
+    {
+#if defined(_WIN32)
+        struct _stat64 info{};
+
+        if (_fstat64(fd, &info) != 0 || (info.st_mode & _S_IFREG) == 0)
+            return 0;
+#else
+        struct stat info{};
+
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+            return 0;
+#endif
+
+        return static_cast<size_t>(info.st_size);
+    }
+
+    static size_t Read(int fd, void* buffer, size_t length)
+    {
+        while (true)
+        {
+#if defined(_WIN32)
+            int result = _read(fd, buffer, static_cast<unsigned int>(std::min<size_t>(length, INT_MAX)));
+#else
+            ssize_t result = read(fd, buffer, std::min<size_t>(length, SSIZE_MAX));
+#endif
+
+            if (result >= 0)
+                return static_cast<size_t>(result);
+
+            if (errno != EINTR)
+                throw std::runtime_error("Failed to read from file descriptor.");
+        }
+    }
+
+    static void WriteAll(int fd, const void* buffer, size_t length)
+    {
+        const char* cursor = static_cast<const char*>(buffer);
+
+        while (length > 0)
+        {
+#if defined(_WIN32)
+            int result = _write(fd, cursor, static_cast<unsigned int>(std::min<size_t>(length, INT_MAX)));
+#else
+            ssize_t result = write(fd, cursor, std::min<size_t>(length, SSIZE_MAX));
+#endif
+
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                throw std::runtime_error("Failed to write to file descriptor.");
+            }
+
+            cursor += result;
+            length -= static_cast<size_t>(result);
+        }
+    }
+
+    // Reads until end of file or until limit bytes, which must be whole characters.
+    // The size reported by fstat only sizes the buffer, so a file that grows
+    // while it is read is still read to its end. A stream that ends partway
+    // through a character throws after those bytes have been consumed.
+    template <typename T, typename A>
+    static size_t ReadInto(int fd, std::basic_string<T, std::char_traits<T>, A>& target, size_t limit = Unlimited, size_t chunkSize = DefaultChunkSize)
+    {
+        if (limit != Unlimited && limit % sizeof(T) != 0)
+            throw std::runtime_error("Read limit is not a multiple of the character size.");
+
+        size_t offset = target.length() * sizeof(T);
+        size_t hint = std::min(SizeHint(fd), limit);
+        size_t total = 0;
+
+        chunkSize = std::max(chunkSize, sizeof(T));
+
+        if (hint != 0)
+            target.reserve((offset + hint + chunkSize) / sizeof(T) + 1);
+
+        while (total < limit)
+        {
+            size_t want = std::min(limit - total, total < hint ? hint - total : chunkSize);
+
+            target.resize((offset + total + want + sizeof(T) - 1) / sizeof(T));
+
+            size_t count = Read(fd, reinterpret_cast<char*>(target.data()) + offset + total, want);
+
+            if (count == 0)
+                break;
+
+            total += count;
+        }
+
+        if (total % sizeof(T) != 0)
+            throw std::runtime_error("File length is not a multiple of the character size.");
+
+        target.resize((offset + total) / sizeof(T));
+
+        return total;
+    }
+
+};
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+class HazardDomain
+{
+
+public:
+
+    static constexpr size_t SlotsPerThread = 4;
+    static constexpr size_t RetireThreshold = 64;
+
+    using deleter_type = void(*)(void*);
+
+    HazardDomain(const HazardDomain&) = delete;
+    HazardDomain& operator=(const HazardDomain&) = delete;
+
+    ~HazardDomain()
+    {
+        for (const Retired& retired : orphans)
+            retired.deleter(retired.pointer);
+
+        Record* record = head.load(std::memory_order_acquire);
+
+        while (record != nullptr)
+        {
+            Record* next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    static HazardDomain& Instance()
+    {
+        static HazardDomain domain;
+        return domain;
+    }
+
+    template <typename P>
+    static void Retire(P* pointer)
+    {
+        Retire(const_cast<void*>(static_cast<const void*>(pointer)), [](void* erased) { delete static_cast<P*>(erased); });
+    }
+
+    static void Retire(void* pointer, deleter_type deleter)
+    {
+        ThreadState& state = Local();
+
+        state.retired.push_back({ pointer, deleter });
+
+        if (state.retired.size() >= RetireThreshold)
+            Instance().Scan(state.retired);
+    }
+
+private:
+
+    friend class HazardGuard;
+
+    struct alignas(64) Record
+    {
+        std::atomic<const void*> slots[SlotsPerThread] = {};
+        std::atomic<bool> active = true;
+        Record* next = nullptr;
+    };
+
+    struct Retired
+    {
+        void* pointer;
+        deleter_type deleter;
+    };
+
+    struct ThreadState
+    {
+        ThreadState() : domain(Instance()), record(domain.AcquireRecord()) {}
+
+        ~ThreadState()
+        {
+            domain.Scan(retired);
+
+            if (!retired.empty())
+            {
+                std::lock_guard<std::mutex> lock(domain.orphanMutex);
+                domain.orphans.insert(domain.orphans.end(), retired.begin(), retired.end());
+            }
+
+            record->active.store(false, std::memory_order_release);
+        }
+
+        HazardDomain& domain;
+        Record* record;
+        size_t usedSlots = 0;
+        std::vector<Retired> retired;
+    };
+
+    HazardDomain() = default;
+
+    static ThreadState& Local()
+    {
+        thread_local ThreadState state;
+        return state;
+    }
+
+    Record* AcquireRecord()
+    {
+        for (Record* record = head.load(std::memory_order_acquire); record != nullptr; record = record->next)
+        {
+            bool expected = false;
+
+            if (record->active.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                return record;
+        }
+
+        Record* record = new Record();
+        Record* expectedHead = head.load(std::memory_order_relaxed);
+
+        do
+            record->next = expectedHead;
+        while (!head.compare_exchange_weak(expectedHead, record, std::memory_order_release, std::memory_order_relaxed));
+
+        return record;
+    }
+
+    void Scan(std::vector<Retired>& retired)
+    {
+        {
+            std::lock_guard<std::mutex> lock(orphanMutex);
+
+            if (!orphans.empty())
+            {
+                retired.insert(retired.end(), orphans.begin(), orphans.end());
+                orphans.clear();
+            }
+        }
+
+        std::vector<const void*> hazards;
+
+        for (Record* record = head.load(std::memory_order_acquire); record != nullptr; record = record->next)
+        {
+            for (const std::atomic<const void*>& slot : record->slots)
+            {
+                const void* pointer = slot.load(std::memory_order_seq_cst);
+
+                if (pointer != nullptr)
+                    hazards.push_back(pointer);
+            }
+        }
+
+        std::sort(hazards.begin(), hazards.end());
+
+        auto firstReclaimable = std::partition(retired.begin(), retired.end(), [&hazards](const Retired& entry)
+        {
+            return std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(entry.pointer));
+        });
+
+        std::vector<Retired> reclaimable(firstReclaimable, retired.end());
+
+        retired.erase(firstReclaimable, retired.end());
+
+        for (const Retired& entry : reclaimable)
+            entry.deleter(entry.pointer);
+    }
+
+    std::atomic<Record*> head = nullptr;
+
+    std::mutex orphanMutex;
+    std::vector<Retired> orphans;
+
+};
+
+class HazardGuard
+{
+
+public:
+
+    HazardGuard()
+    {
+        HazardDomain::ThreadState& state = HazardDomain::Local();
+
+        if (state.usedSlots == HazardDomain::SlotsPerThread)
+            throw std::runtime_error("Too many nested hazard guards on one thread.");
+
+        slot = &state.record->slots[state.usedSlots++];
+    }
+
+    ~HazardGuard()
+    {
+        slot->store(nullptr, std::memory_order_release);
+        --HazardDomain::Local().usedSlots;
+    }
+
+    HazardGuard(const HazardGuard&) = delete;
+    HazardGuard& operator=(const HazardGuard&) = delete;
+
+    template <typename P>
+    P* Protect(const std::atomic<P*>& source)
+    {
+        P* pointer = source.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            slot->store(pointer, std::memory_order_seq_cst);
+
+            P* current = source.load(std::memory_order_seq_cst);
+
+            if (current == pointer)
+                return pointer;
+
+            pointer = current;
+        }
+    }
+
+    void Reset()
+    {
+        slot->store(nullptr, std::memory_order_release);
+    }
+
+private:
+
+    std::atomic<const void*>* slot;
+
+};
@@ -0,0 +1,441 @@
+#pragma once
+
+#if defined(ATOMICBASE_INSTRUMENTATION)
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <bit>
+
+enum class LockMode : std::uint8_t
+{
+    Shared,
+    Exclusive,
+    Count
+};
+
+enum class LockOperation : std::uint8_t
+{
+    Other,
+    Read,
+    Modify,
+    Assign,
+    Compare,
+    Append,
+    Remove,
+    FindAndReplace,
+    Search,
+    ToUpper,
+    ToLower,
+    Convert,
+    Iterate,
+    Hash,
+    Count
+};
+
+class LockStatistics
+{
+
+public:
+
+    static constexpr size_t ShardCount = 8;
+    static constexpr size_t BucketCount = 24;
+    static constexpr size_t ModeCount = static_cast<size_t>(LockMode::Count);
+    static constexpr size_t OperationCount = static_cast<size_t>(LockOperation::Count);
+
+    using histogram_type = std::array<std::uint64_t, BucketCount>;
+
+    struct Entry
+    {
+        LockOperation operation = LockOperation::Other;
+        LockMode mode = LockMode::Shared;
+        std::uint64_t acquisitions = 0;
+        std::uint64_t waitNanoseconds = 0;
+        std::uint64_t holdNanoseconds = 0;
+        histogram_type waitHistogram{};
+        histogram_type holdHistogram{};
+    };
+
+    struct Snapshot
+    {
+        std::string tag;
+        std::uint64_t bytes = 0;
+        std::vector<Entry> entries;
+    };
+
+    LockStatistics() = default;
+
+    explicit LockStatistics(std::string_view tag) : tag(tag) {}
+
+    LockStatistics(const LockStatistics&) = delete;
+    LockStatistics& operator=(const LockStatistics&) = delete;
+
+    static std::shared_ptr<LockStatistics> ForTag(std::string_view tag)
+    {
+        Registry& registry = Tags();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto found = registry.statistics.find(tag);
+
+        if (found != registry.statistics.end())
+            return found->second;
+
+        auto created = std::make_shared<LockStatistics>(tag);
+        registry.statistics.emplace(std::string(tag), created);
+
+        return created;
+    }
+
+    static std::vector<Snapshot> SnapshotAll()
+    {
+        Registry& registry = Tags();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        std::vector<Snapshot> snapshots;
+
+        for (const auto& [name, statistics] : registry.statistics)
+            snapshots.push_back(statistics->Take());
+
+        return snapshots;
+    }
+
+    static const char* Name(LockOperation operation)
+    {
+        static constexpr const char* names[OperationCount] =
+        {
+            "Other", "Read", "Modify", "Assign", "Compare", "Append", "Remove",
+            "FindAndReplace", "Search", "ToUpper", "ToLower", "Convert", "Iterate", "Hash"
+        };
+
+        return names[static_cast<size_t>(operation)];
+    }
+
+    static const char* Name(LockMode mode)
+    {
+        return mode == LockMode::Shared ? "Shared" : "Exclusive";
+    }
+
+    static std::uint64_t BucketLimit(size_t bucket)
+    {
+        return bucket + 1 < BucketCount ? std::uint64_t(1) << (bucket + 6) : ~std::uint64_t(0);
+    }
+
+    void RecordWait(LockMode mode, LockOperation operation, std::uint64_t nanoseconds)
+    {
+        Counters& counters = Local().counters[static_cast<size_t>(mode)][static_cast<size_t>(operation)];
+
+        counters.acquisitions.fetch_add(1, std::memory_order_relaxed);
+        counters.waitNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        counters.waitHistogram[BucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordHold(LockMode mode, LockOperation operation, std::uint64_t nanoseconds)
+    {
+        Counters& counters = Local().counters[static_cast<size_t>(mode)][static_cast<size_t>(operation)];
+
+        counters.holdNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        counters.holdHistogram[BucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void RecordBytes(std::uint64_t bytes)
+    {
+        Local().bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    Snapshot Take() const
+    {
+        Snapshot snapshot;
+
+        snapshot.tag = tag;
+
+        for (size_t mode = 0; mode < ModeCount; ++mode)
+        {
+            for (size_t operation = 0; operation < OperationCount; ++operation)
+            {
+                Entry entry;
+
+                entry.mode = static_cast<LockMode>(mode);
+                entry.operation = static_cast<LockOperation>(operation);
+
+                for (const Shard& shard : shards)
+                {
+                    const Counters& counters = shard.counters[mode][operation];
+
+                    entry.acquisitions += counters.acquisitions.load(std::memory_order_relaxed);
+                    entry.waitNanoseconds += counters.waitNanoseconds.load(std::memory_order_relaxed);
+                    entry.holdNanoseconds += counters.holdNanoseconds.load(std::memory_order_relaxed);
+
+                    for (size_t bucket = 0; bucket < BucketCount; ++bucket)
+                    {
+                        entry.waitHistogram[bucket] += counters.waitHistogram[bucket].load(std::memory_order_relaxed);
+                        entry.holdHistogram[bucket] += counters.holdHistogram[bucket].load(std::memory_order_relaxed);
+                    }
+                }
+
+                if (entry.acquisitions != 0)
+                    snapshot.entries.push_back(entry);
+            }
+        }
+
+        for (const Shard& shard : shards)
+            snapshot.bytes += shard.bytes.load(std::memory_order_relaxed);
+
+        return snapshot;
+    }
+
+    std::string_view Tag() const
+    {
+        return tag;
+    }
+
+private:
+
+    struct Counters
+    {
+        std::atomic<std::uint64_t> acquisitions = 0;
+        std::atomic<std::uint64_t> waitNanoseconds = 0;
+        std::atomic<std::uint64_t> holdNanoseconds = 0;
+        std::array<std::atomic<std::uint64_t>, BucketCount> waitHistogram{};
+        std::array<std::atomic<std::uint64_t>, BucketCount> holdHistogram{};
+    };
+
+    struct alignas(64) Shard
+    {
+        Counters counters[ModeCount][OperationCount];
+        std::atomic<std::uint64_t> bytes = 0;
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::map<std::string, std::shared_ptr<LockStatistics>, std::less<>> statistics;
+    };
+
+    static Registry& Tags()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    static size_t BucketOf(std::uint64_t nanoseconds)
+    {
+        size_t bucket = static_cast<size_t>(std::bit_width(nanoseconds >> 6));
+        return bucket < BucketCount ? bucket : BucketCount - 1;
+    }
+
+    static size_t ThreadShard()
+    {
+        static std::atomic<size_t> next = 0;
+        thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % ShardCount;
+        return index;
+    }
+
+    Shard& Local()
+    {
+        return shards[ThreadShard()];
+    }
+
+    std::string tag;
+    Shard shards[ShardCount];
+
+};
+
+class LockOperationScope
+{
+
+public:
+
+    explicit LockOperationScope(LockOperation operation) : previous(current)
+    {
+        if (current == LockOperation::Other)
+            current = operation;
+    }
+
+    ~LockOperationScope()
+    {
+        current = previous;
+    }
+
+    LockOperationScope(const LockOperationScope&) = delete;
+    LockOperationScope& operator=(const LockOperationScope&) = delete;
+
+    static LockOperation Current()
+    {
+        return current;
+    }
+
+private:
+
+    static inline thread_local LockOperation current = LockOperation::Other;
+
+    LockOperation previous;
+
+};
+
+template <typename M>
+class InstrumentedMutex
+{
+
+public:
+
+    void lock()
+    {
+        LockStatistics* target = statistics.load(std::memory_order_acquire);
+
+        if (target == nullptr)
+        {
+            inner.lock();
+            exclusiveSince = 0;
+            return;
+        }
+
+        std::uint64_t start = Now();
+
+        inner.lock();
+
+        exclusiveSince = Now();
+        exclusiveOperation = LockOperationScope::Current();
+        target->RecordWait(LockMode::Exclusive, exclusiveOperation, exclusiveSince - start);
+    }
+
+    bool try_lock()
+    {
+        if (!inner.try_lock())
+            return false;
+
+        LockStatistics* target = statistics.load(std::memory_order_acquire);
+
+        exclusiveSince = target != nullptr ? Now() : 0;
+        exclusiveOperation = LockOperationScope::Current();
+
+        if (target != nullptr)
+            target->RecordWait(LockMode::Exclusive, exclusiveOperation, 0);
+
+        return true;
+    }
+
+    void unlock()
+    {
+        LockStatistics* target = statistics.load(std::memory_order_acquire);
+
+        if (target != nullptr && exclusiveSince != 0)
+            target->RecordHold(LockMode::Exclusive, exclusiveOperation, Now() - exclusiveSince);
+
+        inner.unlock();
+    }
+
+    void lock_shared()
+    {
+        LockStatistics* target = statistics.load(std::memory_order_acquire);
+
+        if (target == nullptr)
+        {
+            inner.lock_shared();
+            return;
+        }
+
+        std::uint64_t start = Now();
+
+        inner.lock_shared();
+
+        std::uint64_t acquired = Now();
+        LockOperation operation = LockOperationScope::Current();
+
+        target->RecordWait(LockMode::Shared, operation, acquired - start);
+        SharedHolds().push_back({ this, acquired, operation });
+    }
+
+    bool try_lock_shared()
+    {
+        if (!inner.try_lock_shared())
+            return false;
+
+        if (LockStatistics* target = statistics.load(std::memory_order_acquire))
+        {
+            LockOperation operation = LockOperationScope::Current();
+
+            target->RecordWait(LockMode::Shared, operation, 0);
+            SharedHolds().push_back({ this, Now(), operation });
+        }
+
+        return true;
+    }
+
+    void unlock_shared()
+    {
+        std::vector<Hold>& holds = SharedHolds();
+
+        for (size_t i = holds.size(); i-- > 0; )
+        {
+            if (holds[i].owner != this)
+                continue;
+
+            if (LockStatistics* target = statistics.load(std::memory_order_acquire))
+                target->RecordHold(LockMode::Shared, holds[i].operation, Now() - holds[i].since);
+
+            holds.erase(holds.begin() + static_cast<std::ptrdiff_t>(i));
+            break;
+        }
+
+        inner.unlock_shared();
+    }
+
+    M& Inner()
+    {
+        return inner;
+    }
+
+    void Attach(LockStatistics* target)
+    {
+        statistics.store(target, std::memory_order_release);
+    }
+
+    void RecordBytes(std::uint64_t bytes)
+    {
+        if (LockStatistics* target = statistics.load(std::memory_order_relaxed))
+            target->RecordBytes(bytes);
+    }
+
+private:
+
+    struct Hold
+    {
+        const InstrumentedMutex* owner;
+        std::uint64_t since;
+        LockOperation operation;
+    };
+
+    static std::vector<Hold>& SharedHolds()
+    {
+        thread_local std::vector<Hold> holds;
+        return holds;
+    }
+
+    static std::uint64_t Now()
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    M inner;
+    std::atomic<LockStatistics*> statistics = nullptr;
+    std::uint64_t exclusiveSince = 0;
+    LockOperation exclusiveOperation = LockOperation::Other;
+
+};
+
+#define ATOMICBASE_OPERATION(name) LockOperationScope atomicBaseOperationScope(LockOperation::name)
+#define ATOMICBASE_RECORD_BYTES(mutex, bytes) (mutex).RecordBytes(bytes)
+
+#else
+
+#define ATOMICBASE_OPERATION(name)
+#define ATOMICBASE_RECORD_BYTES(mutex, bytes)
+
+#endif
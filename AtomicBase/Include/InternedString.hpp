@@ -0,0 +1,241 @@
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include "AtomicString.hpp"
+
+template <typename T>
+class AtomicStringPool;
+
+template <typename T>
+class InternedString
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+
+    InternedString() = default;
+
+    view_type View() const
+    {
+        return entry != nullptr ? view_type(entry->data) : view_type();
+    }
+
+    size_t Hash() const
+    {
+        return entry != nullptr ? entry->hash : EmptyHash();
+    }
+
+    size_t Length() const
+    {
+        return View().length();
+    }
+
+    bool Empty() const
+    {
+        return entry == nullptr;
+    }
+
+    bool operator==(const InternedString& other) const
+    {
+        return entry == other.entry;
+    }
+
+    bool operator!=(const InternedString& other) const
+    {
+        return entry != other.entry;
+    }
+
+    bool operator==(view_type other) const
+    {
+        return View() == other;
+    }
+
+    bool operator!=(view_type other) const
+    {
+        return View() != other;
+    }
+
+    operator view_type() const
+    {
+        return View();
+    }
+
+    template <typename P = SharedMutexLockPolicy, typename A = std::allocator<T>>
+    AtomicString<T, P, A> ToAtomicString(const A& allocator = A()) const
+    {
+        return AtomicString<T, P, A>(View(), allocator);
+    }
+
+private:
+
+    friend class AtomicStringPool<T>;
+
+    struct Entry
+    {
+        Entry(view_type text, size_t hash) : hash(hash), data(text) {}
+
+        const size_t hash;
+        const string_type data;
+    };
+
+    explicit InternedString(const Entry* entry) : entry(entry) {}
+
+    static size_t EmptyHash()
+    {
+        static const size_t hash = std::hash<view_type>{}(view_type());
+        return hash;
+    }
+
+    const Entry* entry = nullptr;
+
+};
+
+template <typename T>
+class AtomicStringPool
+{
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+    using handle_type = InternedString<T>;
+
+    static constexpr size_t ShardCount = 64;
+
+    AtomicStringPool() = default;
+
+    AtomicStringPool(const AtomicStringPool&) = delete;
+    AtomicStringPool& operator=(const AtomicStringPool&) = delete;
+
+    static AtomicStringPool& Instance()
+    {
+        static AtomicStringPool pool;
+        return pool;
+    }
+
+    handle_type Intern(view_type str)
+    {
+        return InternHashed(str, std::hash<view_type>{}(str));
+    }
+
+    handle_type Intern(const string_type& str)
+    {
+        return Intern(view_type(str));
+    }
+
+    handle_type Intern(const T* str)
+    {
+        return Intern(view_type(str));
+    }
+
+    template <typename P, typename A>
+    handle_type Intern(const AtomicString<T, P, A>& str)
+    {
+        return str.ReadHashed([this](const typename AtomicString<T, P, A>::string_type& data, size_t hash) { return InternHashed(view_type(data), hash); });
+    }
+
+    size_t Size() const
+    {
+        size_t size = 0;
+
+        for (const Shard& shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            size += shard.entries.size();
+        }
+
+        return size;
+    }
+
+private:
+
+    using entry_type = typename handle_type::Entry;
+
+    struct Key
+    {
+        view_type text;
+        size_t hash;
+
+        bool operator==(const Key& other) const
+        {
+            return hash == other.hash && text == other.text;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return key.hash;
+        }
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, std::unique_ptr<entry_type>, KeyHash> entries;
+    };
+
+    handle_type InternHashed(view_type str, size_t hash)
+    {
+        if (str.empty())
+            return handle_type();
+
+        Key key{ str, hash };
+        Shard& shard = shards[(key.hash >> 7) % ShardCount];
+
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            auto found = shard.entries.find(key);
+
+            if (found != shard.entries.end())
+                return handle_type(found->second.get());
+        }
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto found = shard.entries.find(key);
+
+        if (found != shard.entries.end())
+            return handle_type(found->second.get());
+
+        auto entry = std::make_unique<entry_type>(str, key.hash);
+        const entry_type* result = entry.get();
+
+        shard.entries.emplace(Key{ view_type(result->data), key.hash }, std::move(entry));
+
+        return handle_type(result);
+    }
+
+    Shard shards[ShardCount];
+
+};
+
+template <typename T>
+std::basic_ostream<T>& operator<<(std::basic_ostream<T>& stream, const InternedString<T>& str)
+{
+    return stream << str.View();
+}
+
+template <typename T>
+struct std::hash<InternedString<T>>
+{
+    size_t operator()(const InternedString<T>& str) const noexcept
+    {
+        return str.Hash();
+    }
+};
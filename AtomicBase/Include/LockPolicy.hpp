@@ -0,0 +1,774 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <coroutine>
+#include <thread>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+class SpinBackoff
+{
+
+public:
+
+    static constexpr std::uint32_t SpinLimit = 64;
+
+    static void CpuRelax()
+    {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+        _mm_pause();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+        __yield();
+#elif defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        asm volatile("yield");
+#endif
+    }
+
+    void Pause()
+    {
+        if (count <= SpinLimit)
+        {
+            for (std::uint32_t i = 0; i < count; ++i)
+                CpuRelax();
+
+            count <<= 1;
+        }
+        else
+            std::this_thread::yield();
+    }
+
+    bool Exhausted() const
+    {
+        return count > SpinLimit;
+    }
+
+private:
+
+    std::uint32_t count = 1;
+
+};
+
+class SpinSharedMutex
+{
+
+public:
+
+    SpinSharedMutex() = default;
+    SpinSharedMutex(const SpinSharedMutex&) = delete;
+    SpinSharedMutex& operator=(const SpinSharedMutex&) = delete;
+
+    void lock()
+    {
+        SpinBackoff backoff;
+
+        while (!try_lock())
+        {
+            state.fetch_or(PendingBit, std::memory_order_relaxed);
+            backoff.Pause();
+        }
+    }
+
+    bool try_lock()
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        if ((current & ~PendingBit) != 0)
+            return false;
+
+        return state.compare_exchange_strong(current, WriterBit, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        state.store(0, std::memory_order_release);
+    }
+
+    void lock_shared()
+    {
+        SpinBackoff backoff;
+
+        while (!try_lock_shared())
+            backoff.Pause();
+    }
+
+    bool try_lock_shared()
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        while ((current & (WriterBit | PendingBit)) == 0)
+        {
+            if (state.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    void unlock_shared()
+    {
+        state.fetch_sub(1, std::memory_order_release);
+    }
+
+private:
+
+    static constexpr std::uint32_t WriterBit = 1u << 31;
+    static constexpr std::uint32_t PendingBit = 1u << 30;
+
+    std::atomic<std::uint32_t> state = 0;
+
+};
+
+class AdaptiveSharedMutex
+{
+
+public:
+
+    AdaptiveSharedMutex() = default;
+    AdaptiveSharedMutex(const AdaptiveSharedMutex&) = delete;
+    AdaptiveSharedMutex& operator=(const AdaptiveSharedMutex&) = delete;
+
+    void lock()
+    {
+        SpinBackoff backoff;
+
+        while (!try_lock())
+        {
+            state.fetch_or(PendingBit, std::memory_order_relaxed);
+
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                Park([](std::uint32_t current) { return (current & ~PendingBit) == 0; });
+        }
+    }
+
+    bool try_lock()
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        if ((current & ~PendingBit) != 0)
+            return false;
+
+        return state.compare_exchange_strong(current, WriterBit, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        state.store(0, std::memory_order_seq_cst);
+        Wake();
+    }
+
+    void lock_shared()
+    {
+        SpinBackoff backoff;
+
+        while (!try_lock_shared())
+        {
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                Park([](std::uint32_t current) { return (current & (WriterBit | PendingBit)) == 0; });
+        }
+    }
+
+    bool try_lock_shared()
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        while ((current & (WriterBit | PendingBit)) == 0)
+        {
+            if (state.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    void unlock_shared()
+    {
+        if ((state.fetch_sub(1, std::memory_order_seq_cst) & ReaderMask) == 1)
+            Wake();
+    }
+
+private:
+
+    static constexpr std::uint32_t WriterBit = 1u << 31;
+    static constexpr std::uint32_t PendingBit = 1u << 30;
+    static constexpr std::uint32_t ReaderMask = PendingBit - 1;
+
+    template <typename F>
+    void Park(F&& available)
+    {
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+
+        std::uint32_t current = state.load(std::memory_order_seq_cst);
+
+        if (!available(current))
+            state.wait(current, std::memory_order_relaxed);
+
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void Wake()
+    {
+        if (waiters.load(std::memory_order_seq_cst) != 0)
+            state.notify_all();
+    }
+
+    std::atomic<std::uint32_t> state = 0;
+    std::atomic<std::uint32_t> waiters = 0;
+
+};
+
+class FutexSharedMutex
+{
+
+public:
+
+    FutexSharedMutex() = default;
+    FutexSharedMutex(const FutexSharedMutex&) = delete;
+    FutexSharedMutex& operator=(const FutexSharedMutex&) = delete;
+
+    void lock()
+    {
+        SpinBackoff backoff;
+
+        while (!try_lock())
+        {
+            state.fetch_or(PendingBit, std::memory_order_relaxed);
+
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                Park([](std::uint32_t current) { return (current & ~(PendingBit | ParkedBit)) == 0; });
+        }
+    }
+
+    bool try_lock()
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        if ((current & ~(PendingBit | ParkedBit)) != 0)
+            return false;
+
+        return state.compare_exchange_strong(current, WriterBit | (current & ParkedBit), std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock()
+    {
+        if ((state.exchange(0, std::memory_order_release) & ParkedBit) != 0)
+            state.notify_all();
+    }
+
+    void lock_shared()
+    {
+        SpinBackoff backoff;
+
+        while (!try_lock_shared())
+        {
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                Park([](std::uint32_t current) { return (current & (WriterBit | PendingBit)) == 0; });
+        }
+    }
+
+    bool try_lock_shared()
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        while ((current & (WriterBit | PendingBit)) == 0)
+        {
+            if (state.compare_exchange_weak(current, current + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    void unlock_shared()
+    {
+        std::uint32_t previous = state.fetch_sub(1, std::memory_order_release);
+
+        if ((previous & ReaderMask) == 1 && (previous & ParkedBit) != 0)
+        {
+            state.fetch_and(~ParkedBit, std::memory_order_relaxed);
+            state.notify_all();
+        }
+    }
+
+private:
+
+    static constexpr std::uint32_t WriterBit = 1u << 31;
+    static constexpr std::uint32_t PendingBit = 1u << 30;
+    static constexpr std::uint32_t ParkedBit = 1u << 29;
+    static constexpr std::uint32_t ReaderMask = ParkedBit - 1;
+
+    template <typename F>
+    void Park(F&& available)
+    {
+        std::uint32_t current = state.load(std::memory_order_relaxed);
+
+        if (available(current))
+            return;
+
+        if ((current & ParkedBit) == 0 && !state.compare_exchange_strong(current, current | ParkedBit, std::memory_order_relaxed, std::memory_order_relaxed))
+            return;
+
+        state.wait(current | ParkedBit, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint32_t> state = 0;
+
+};
+
+template <size_t SlotCount = 32>
+class DistributedSharedMutex
+{
+
+public:
+
+    DistributedSharedMutex() = default;
+    DistributedSharedMutex(const DistributedSharedMutex&) = delete;
+    DistributedSharedMutex& operator=(const DistributedSharedMutex&) = delete;
+
+    void lock()
+    {
+        SpinBackoff backoff;
+
+        while (!AcquireWriter())
+        {
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                Park();
+        }
+
+        for (Slot& slot : slots)
+            Drain(slot.readers);
+    }
+
+    bool try_lock()
+    {
+        if (!AcquireWriter())
+            return false;
+
+        for (Slot& slot : slots)
+        {
+            if (slot.readers.load(std::memory_order_seq_cst) != 0)
+            {
+                unlock();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void unlock()
+    {
+        if ((writer.exchange(0, std::memory_order_seq_cst) & ParkedBit) != 0)
+            writer.notify_all();
+    }
+
+    void lock_shared()
+    {
+        std::atomic<std::uint32_t>& readers = slots[ThreadSlot()].readers;
+        SpinBackoff backoff;
+
+        while (!TryEnter(readers))
+        {
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                Park();
+        }
+    }
+
+    bool try_lock_shared()
+    {
+        return TryEnter(slots[ThreadSlot()].readers);
+    }
+
+    void unlock_shared()
+    {
+        Leave(slots[ThreadSlot()].readers);
+    }
+
+private:
+
+    static constexpr std::uint32_t LockedBit = 1;
+    static constexpr std::uint32_t ParkedBit = 2;
+
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint32_t> readers = 0;
+    };
+
+    static size_t ThreadSlot()
+    {
+        static std::atomic<size_t> next = 0;
+        thread_local size_t slot = next.fetch_add(1, std::memory_order_relaxed) % SlotCount;
+        return slot;
+    }
+
+    bool AcquireWriter()
+    {
+        std::uint32_t expected = 0;
+        return writer.compare_exchange_strong(expected, LockedBit, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool TryEnter(std::atomic<std::uint32_t>& readers)
+    {
+        readers.fetch_add(1, std::memory_order_seq_cst);
+
+        if ((writer.load(std::memory_order_seq_cst) & LockedBit) == 0)
+            return true;
+
+        Leave(readers);
+
+        return false;
+    }
+
+    void Leave(std::atomic<std::uint32_t>& readers)
+    {
+        if (readers.fetch_sub(1, std::memory_order_seq_cst) == 1 && (writer.load(std::memory_order_seq_cst) & LockedBit) != 0)
+            readers.notify_all();
+    }
+
+    void Drain(std::atomic<std::uint32_t>& readers)
+    {
+        SpinBackoff backoff;
+
+        for (std::uint32_t current = readers.load(std::memory_order_seq_cst); current != 0; current = readers.load(std::memory_order_seq_cst))
+        {
+            if (!backoff.Exhausted())
+                backoff.Pause();
+            else
+                readers.wait(current, std::memory_order_seq_cst);
+        }
+    }
+
+    void Park()
+    {
+        std::uint32_t current = writer.load(std::memory_order_relaxed);
+
+        if ((current & LockedBit) == 0)
+            return;
+
+        if ((current & ParkedBit) == 0 && !writer.compare_exchange_strong(current, current | ParkedBit, std::memory_order_relaxed, std::memory_order_relaxed))
+            return;
+
+        writer.wait(current | ParkedBit, std::memory_order_relaxed);
+    }
+
+    Slot slots[SlotCount];
+    alignas(64) std::atomic<std::uint32_t> writer = 0;
+
+};
+
+class AsyncSharedMutex
+{
+
+public:
+
+    struct InlineExecutor
+    {
+        void operator()(std::coroutine_handle<> handle) const
+        {
+            handle.resume();
+        }
+    };
+
+    class Waiter
+    {
+
+    private:
+
+        friend class AsyncSharedMutex;
+
+        Waiter* next = nullptr;
+        bool exclusive = false;
+        bool granted = false;
+        void (*resume)(Waiter&) = nullptr;
+
+    };
+
+    template <typename Executor>
+    class Acquire : private Waiter
+    {
+
+    public:
+
+        Acquire(AsyncSharedMutex& owner, bool exclusive, Executor executor) : owner(owner), executor(std::move(executor))
+        {
+            this->exclusive = exclusive;
+            this->resume = &Acquire::Resume;
+        }
+
+        Acquire(const Acquire&) = delete;
+        Acquire& operator=(const Acquire&) = delete;
+
+        bool await_ready()
+        {
+            return exclusive ? owner.try_lock() : owner.try_lock_shared();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting)
+        {
+            handle = awaiting;
+            return owner.Enqueue(*this);
+        }
+
+        void await_resume() {}
+
+    private:
+
+        static void Resume(Waiter& waiter)
+        {
+            Acquire& self = static_cast<Acquire&>(waiter);
+            self.executor(self.handle);
+        }
+
+        AsyncSharedMutex& owner;
+        Executor executor;
+        std::coroutine_handle<> handle;
+
+    };
+
+    AsyncSharedMutex() = default;
+    AsyncSharedMutex(const AsyncSharedMutex&) = delete;
+    AsyncSharedMutex& operator=(const AsyncSharedMutex&) = delete;
+
+    template <typename Executor = InlineExecutor>
+    Acquire<Executor> LockAsync(Executor executor = Executor())
+    {
+        return Acquire<Executor>(*this, true, std::move(executor));
+    }
+
+    template <typename Executor = InlineExecutor>
+    Acquire<Executor> LockSharedAsync(Executor executor = Executor())
+    {
+        return Acquire<Executor>(*this, false, std::move(executor));
+    }
+
+    void lock()
+    {
+        Wait(true);
+    }
+
+    bool try_lock()
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        return TryAcquire(true);
+    }
+
+    void unlock()
+    {
+        std::unique_lock<std::mutex> lock(guard);
+        writer = false;
+        Dispatch(lock);
+    }
+
+    void lock_shared()
+    {
+        Wait(false);
+    }
+
+    bool try_lock_shared()
+    {
+        std::lock_guard<std::mutex> lock(guard);
+        return TryAcquire(false);
+    }
+
+    void unlock_shared()
+    {
+        std::unique_lock<std::mutex> lock(guard);
+
+        if (--readers == 0)
+            Dispatch(lock);
+    }
+
+private:
+
+    bool Available(bool exclusive) const
+    {
+        return !writer && (!exclusive || readers == 0);
+    }
+
+    bool TryAcquire(bool exclusive)
+    {
+        if (head != nullptr || !Available(exclusive))
+            return false;
+
+        Take(exclusive);
+
+        return true;
+    }
+
+    void Take(bool exclusive)
+    {
+        if (exclusive)
+            writer = true;
+        else
+            ++readers;
+    }
+
+    void Append(Waiter& waiter)
+    {
+        waiter.next = nullptr;
+
+        if (tail != nullptr)
+            tail->next = &waiter;
+        else
+            head = &waiter;
+
+        tail = &waiter;
+    }
+
+    bool Enqueue(Waiter& waiter)
+    {
+        std::lock_guard<std::mutex> lock(guard);
+
+        if (TryAcquire(waiter.exclusive))
+            return false;
+
+        Append(waiter);
+
+        return true;
+    }
+
+    void Wait(bool exclusive)
+    {
+        std::unique_lock<std::mutex> lock(guard);
+
+        if (TryAcquire(exclusive))
+            return;
+
+        Waiter waiter;
+        waiter.exclusive = exclusive;
+
+        Append(waiter);
+        granted.wait(lock, [&waiter] { return waiter.granted; });
+    }
+
+    void Dispatch(std::unique_lock<std::mutex>& lock)
+    {
+        Waiter* ready = nullptr;
+        Waiter** last = &ready;
+        bool notify = false;
+
+        while (head != nullptr && Available(head->exclusive))
+        {
+            Waiter* waiter = head;
+
+            head = waiter->next;
+
+            if (head == nullptr)
+                tail = nullptr;
+
+            Take(waiter->exclusive);
+
+            if (waiter->resume == nullptr)
+            {
+                waiter->granted = true;
+                notify = true;
+            }
+            else
+            {
+                waiter->next = nullptr;
+                *last = waiter;
+                last = &waiter->next;
+            }
+
+            if (writer)
+                break;
+        }
+
+        lock.unlock();
+
+        if (notify)
+            granted.notify_all();
+
+        while (ready != nullptr)
+        {
+            Waiter* waiter = ready;
+
+            ready = waiter->next;
+            waiter->resume(*waiter);
+        }
+    }
+
+    std::mutex guard;
+    std::condition_variable granted;
+    Waiter* head = nullptr;
+    Waiter* tail = nullptr;
+    size_t readers = 0;
+    bool writer = false;
+
+};
+
+class NullMutex
+{
+
+public:
+
+    void lock() {}
+    bool try_lock() { return true; }
+    void unlock() {}
+
+    void lock_shared() {}
+    bool try_lock_shared() { return true; }
+    void unlock_shared() {}
+
+};
+
+struct SharedMutexLockPolicy
+{
+    using mutex_type = std::shared_mutex;
+    using iterator_mutex_type = std::mutex;
+};
+
+struct SpinLockPolicy
+{
+    using mutex_type = SpinSharedMutex;
+    using iterator_mutex_type = SpinSharedMutex;
+};
+
+struct AdaptiveLockPolicy
+{
+    using mutex_type = AdaptiveSharedMutex;
+    using iterator_mutex_type = AdaptiveSharedMutex;
+};
+
+struct CompactLockPolicy
+{
+    using mutex_type = FutexSharedMutex;
+    using iterator_mutex_type = FutexSharedMutex;
+};
+
+struct DistributedLockPolicy
+{
+    using mutex_type = DistributedSharedMutex<>;
+    using iterator_mutex_type = std::mutex;
+};
+
+struct NullLockPolicy
+{
+    using mutex_type = NullMutex;
+    using iterator_mutex_type = NullMutex;
+};
+
+struct AsyncLockPolicy
+{
+    using mutex_type = AsyncSharedMutex;
+    using iterator_mutex_type = std::mutex;
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "ThreadPool.hpp"
+#include "CaseConversion.hpp"
+#include "Searcher.hpp"
+#include "Transcoder.hpp"
+
+class ParallelTransform
+{
+
+public:
+
+    static constexpr size_t CacheLine = 64;
+    static constexpr size_t MinChunkBytes = 256 * 1024;
+    static constexpr size_t TasksPerThread = 4;
+
+    template <typename T>
+    static std::vector<size_t> Partition(const T* data, size_t length, ThreadPool& pool)
+    {
+        size_t parts = std::max<size_t>(1, std::min(length / (MinChunkBytes / sizeof(T)), pool.Concurrency() * TasksPerThread));
+
+        std::vector<size_t> bounds{ 0 };
+
+        for (size_t k = 1; k < parts; ++k)
+        {
+            size_t cut = length / parts * k;
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(data + cut);
+
+            cut += (CacheLine - address % CacheLine) % CacheLine / sizeof(T);
+
+            if (cut > bounds.back() && cut < length)
+                bounds.push_back(cut);
+        }
+
+        bounds.push_back(length);
+
+        return bounds;
+    }
+
+    template <typename T>
+    static void ToUpper(T* data, size_t length, ThreadPool& pool)
+    {
+        std::vector<size_t> bounds = Partition(data, length, pool);
+
+        pool.ParallelFor(bounds.size() - 1, [data, &bounds](size_t i) { CaseConversion::ToUpper(data + bounds[i], bounds[i + 1] - bounds[i]); });
+    }
+
+    template <typename T>
+    static void ToLower(T* data, size_t length, ThreadPool& pool)
+    {
+        std::vector<size_t> bounds = Partition(data, length, pool);
+
+        pool.ParallelFor(bounds.size() - 1, [data, &bounds](size_t i) { CaseConversion::ToLower(data + bounds[i], bounds[i + 1] - bounds[i]); });
+    }
+
+    template <typename T, typename A>
+    static bool ReplaceAll(std::basic_string<T, std::char_traits<T>, A>& str, std::basic_string_view<T> find, std::basic_string_view<T> replace, ThreadPool& pool)
+    {
+        using view_type = std::basic_string_view<T>;
+
+        if (find.empty())
+            return false;
+
+        view_type source(str);
+        Searcher<T> searcher(find);
+
+        std::vector<size_t> bounds = Partition(source.data(), source.length(), pool);
+        size_t parts = bounds.size() - 1;
+
+        std::vector<std::vector<size_t>> matches(parts);
+
+        pool.ParallelFor(parts, [&](size_t i)
+        {
+            view_type window = source.substr(0, std::min(bounds[i + 1] + find.length() - 1, source.length()));
+
+            for (size_t pos = searcher.Find(window, bounds[i]); pos < bounds[i + 1]; pos = searcher.Find(window, pos + find.length()))
+                matches[i].push_back(pos);
+        });
+
+        std::vector<size_t> starts(parts + 1, 0);
+        std::vector<size_t> offsets(parts + 1, 0);
+        size_t cursor = 0;
+        size_t total = 0;
+
+        for (size_t i = 0; i < parts; ++i)
+        {
+            std::vector<size_t>& chain = matches[i];
+
+            if (!chain.empty() && chain.front() < cursor)
+            {
+                view_type window = source.substr(0, std::min(bounds[i + 1] + find.length() - 1, source.length()));
+                std::vector<size_t> resynced;
+
+                for (size_t pos = searcher.Find(window, cursor); pos < bounds[i + 1]; pos = searcher.Find(window, pos + find.length()))
+                {
+                    auto found = std::lower_bound(chain.begin(), chain.end(), pos);
+
+                    if (found != chain.end() && *found == pos)
+                    {
+                        resynced.insert(resynced.end(), found, chain.end());
+                        break;
+                    }
+
+                    resynced.push_back(pos);
+                }
+
+                chain = std::move(resynced);
+            }
+
+            starts[i] = std::max(bounds[i], cursor);
+
+            if (!chain.empty())
+                cursor = chain.back() + find.length();
+
+            total += chain.size();
+        }
+
+        if (total == 0)
+            return false;
+
+        starts[parts] = source.length();
+
+        for (size_t i = 0; i < parts; ++i)
+        {
+            size_t end = std::max(starts[i + 1], starts[i]);
+            offsets[i + 1] = offsets[i] + (end - starts[i]) + matches[i].size() * replace.length() - matches[i].size() * find.length();
+        }
+
+        std::basic_string<T, std::char_traits<T>, A> result(offsets[parts], T(), str.get_allocator());
+
+        pool.ParallelFor(parts, [&](size_t i)
+        {
+            T* out = result.data() + offsets[i];
+            size_t start = starts[i];
+
+            for (size_t pos : matches[i])
+            {
+                out = std::copy(source.data() + start, source.data() + pos, out);
+                out = std::copy(replace.begin(), replace.end(), out);
+
+                start = pos + find.length();
+            }
+
+            std::copy(source.data() + start, source.data() + std::max(starts[i + 1], start), out);
+        });
+
+        str = std::move(result);
+
+        return true;
+    }
+
+    template <typename F, typename L, typename A = std::allocator<L>>
+    static std::basic_string<L, std::char_traits<L>, A> Convert(std::basic_string_view<F> from, ThreadPool& pool, const A& allocator = A())
+    {
+        std::vector<size_t> bounds = Partition(from.data(), from.length(), pool);
+
+        for (size_t i = 1; i + 1 < bounds.size(); ++i)
+        {
+            for (size_t step = 0; step < 3 && bounds[i] > bounds[i - 1] && !Transcoder::IsLeadingUnit(from[bounds[i]]); ++step)
+                --bounds[i];
+        }
+
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        size_t parts = bounds.size() - 1;
+        std::vector<size_t> offsets(parts + 1, 0);
+
+        pool.ParallelFor(parts, [&](size_t i) { offsets[i + 1] = Transcoder::Measure<F, L>(from.data() + bounds[i], bounds[i + 1] - bounds[i]); });
+
+        for (size_t i = 0; i < parts; ++i)
+            offsets[i + 1] += offsets[i];
+
+        std::basic_string<L, std::char_traits<L>, A> result(offsets[parts], L(), allocator);
+
+        pool.ParallelFor(parts, [&](size_t i) { Transcoder::Write<F, L>(from.data() + bounds[i], bounds[i + 1] - bounds[i], result.data() + offsets[i]); });
+
+        return result;
+    }
+
+};
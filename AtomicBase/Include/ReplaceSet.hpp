@@ -0,0 +1,321 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+#include <type_traits>
+#include <cstdint>
+#include "Searcher.hpp"
+
+template <typename T>
+class ReplaceSet
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+
+    struct Match
+    {
+        size_t position;
+        size_t length;
+        view_type replacement;
+    };
+
+    ReplaceSet(std::initializer_list<std::pair<view_type, view_type>> pairs) : ReplaceSet(pairs.begin(), pairs.end()) {}
+
+    template <typename I>
+    ReplaceSet(I first, I last)
+    {
+        for (; first != last; ++first)
+        {
+            view_type pattern(first->first);
+
+            if (pattern.empty())
+                continue;
+
+            patterns.emplace_back(pattern);
+            replacements.emplace_back(view_type(first->second));
+        }
+
+        Compile();
+    }
+
+    size_t Count() const
+    {
+        return patterns.size();
+    }
+
+    string_type Apply(view_type source) const
+    {
+        std::vector<Match> matches;
+
+        Scan(source, [this, &matches](size_t position, std::int32_t index)
+        {
+            matches.push_back({ position, patterns[index].length(), replacements[index] });
+        });
+
+        return Build(source, matches);
+    }
+
+    template <typename A>
+    bool ApplyTo(std::basic_string<T, std::char_traits<T>, A>& str) const
+    {
+        std::vector<Match> matches;
+
+        Scan(str, [this, &matches](size_t position, std::int32_t index)
+        {
+            matches.push_back({ position, patterns[index].length(), replacements[index] });
+        });
+
+        if (matches.empty())
+            return false;
+
+        str = Build(str, matches, str.get_allocator());
+
+        return true;
+    }
+
+    template <typename A = std::allocator<T>>
+    static std::basic_string<T, std::char_traits<T>, A> ReplaceAll(view_type source, view_type find, view_type replace, const A& allocator = A())
+    {
+        return Build(source, FindAll(source, find, replace), allocator);
+    }
+
+    template <typename A>
+    static bool ReplaceAllIn(std::basic_string<T, std::char_traits<T>, A>& str, view_type find, view_type replace)
+    {
+        std::vector<Match> matches = FindAll(str, find, replace);
+
+        if (matches.empty())
+            return false;
+
+        str = Build(str, matches, str.get_allocator());
+
+        return true;
+    }
+
+    template <typename A = std::allocator<T>>
+    static std::basic_string<T, std::char_traits<T>, A> Build(view_type source, const std::vector<Match>& matches, const A& allocator = A())
+    {
+        size_t length = source.length();
+
+        for (const Match& match : matches)
+            length = length - match.length + match.replacement.length();
+
+        std::basic_string<T, std::char_traits<T>, A> result(length, T(), allocator);
+
+        T* out = result.data();
+        size_t start = 0;
+
+        for (const Match& match : matches)
+        {
+            out = std::copy(source.data() + start, source.data() + match.position, out);
+            out = std::copy(match.replacement.begin(), match.replacement.end(), out);
+
+            start = match.position + match.length;
+        }
+
+        std::copy(source.data() + start, source.data() + source.length(), out);
+
+        return result;
+    }
+
+private:
+
+    static constexpr std::uint32_t Missing = ~std::uint32_t(0);
+
+    static std::vector<Match> FindAll(view_type source, view_type find, view_type replace)
+    {
+        std::vector<Match> matches;
+
+        if (find.empty())
+            return matches;
+
+        Searcher<T> searcher(find);
+
+        for (size_t pos = searcher.Find(source); pos != view_type::npos; pos = searcher.Find(source, pos + find.length()))
+            matches.push_back({ pos, find.length(), replace });
+
+        return matches;
+    }
+
+    static std::uint32_t Unit(T c)
+    {
+        return static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<T>>(c));
+    }
+
+    std::uint32_t ClassOf(T c) const
+    {
+        std::uint32_t unit = Unit(c);
+
+        if (unit < 256)
+            return byteClasses[unit];
+
+        auto found = std::lower_bound(alphabet.begin(), alphabet.end(), unit);
+
+        if (found == alphabet.end() || *found != unit)
+            return 0;
+
+        return static_cast<std::uint32_t>(found - alphabet.begin()) + 1;
+    }
+
+    void Compile()
+    {
+        for (const string_type& pattern : patterns)
+        {
+            for (T c : pattern)
+                alphabet.push_back(Unit(c));
+
+            maxLength = std::max(maxLength, pattern.length());
+        }
+
+        std::sort(alphabet.begin(), alphabet.end());
+        alphabet.erase(std::unique(alphabet.begin(), alphabet.end()), alphabet.end());
+
+        std::fill(std::begin(byteClasses), std::end(byteClasses), 0);
+
+        for (size_t i = 0; i < alphabet.size() && alphabet[i] < 256; ++i)
+            byteClasses[alphabet[i]] = static_cast<std::uint32_t>(i) + 1;
+
+        classes = alphabet.size() + 1;
+
+        AddState();
+
+        for (size_t index = 0; index < patterns.size(); ++index)
+        {
+            std::uint32_t state = 0;
+
+            for (T c : patterns[index])
+            {
+                size_t edge = state * classes + ClassOf(c);
+
+                if (transitions[edge] == Missing)
+                {
+                    std::uint32_t added = AddState();
+                    transitions[edge] = added;
+                }
+
+                state = transitions[edge];
+            }
+
+            outputs[state] = static_cast<std::int32_t>(index);
+        }
+
+        std::vector<std::uint32_t> failure(outputs.size(), 0);
+        std::deque<std::uint32_t> queue;
+
+        for (size_t c = 0; c < classes; ++c)
+        {
+            std::uint32_t& edge = transitions[c];
+
+            if (edge == Missing)
+                edge = 0;
+            else
+                queue.push_back(edge);
+        }
+
+        while (!queue.empty())
+        {
+            std::uint32_t state = queue.front();
+            queue.pop_front();
+
+            std::uint32_t fallback = failure[state];
+            dictionary[state] = outputs[fallback] >= 0 ? fallback : dictionary[fallback];
+
+            for (size_t c = 0; c < classes; ++c)
+            {
+                std::uint32_t& edge = transitions[state * classes + c];
+
+                if (edge == Missing)
+                    edge = transitions[fallback * classes + c];
+                else
+                {
+                    failure[edge] = transitions[fallback * classes + c];
+                    queue.push_back(edge);
+                }
+            }
+        }
+    }
+
+    std::uint32_t AddState()
+    {
+        transitions.resize(transitions.size() + classes, Missing);
+        outputs.push_back(-1);
+        dictionary.push_back(Missing);
+
+        return static_cast<std::uint32_t>(outputs.size() - 1);
+    }
+
+    template <typename F>
+    void Scan(view_type source, F&& emit) const
+    {
+        if (patterns.empty())
+            return;
+
+        std::vector<std::int32_t> longest(maxLength, -1);
+
+        size_t cursor = 0;
+
+        auto settle = [&](size_t start)
+        {
+            std::int32_t& slot = longest[start % maxLength];
+
+            if (slot >= 0 && start >= cursor)
+            {
+                emit(start, slot);
+                cursor = start + patterns[slot].length();
+            }
+
+            slot = -1;
+        };
+
+        std::uint32_t state = 0;
+
+        for (size_t i = 0; i < source.length(); ++i)
+        {
+            state = transitions[state * classes + ClassOf(source[i])];
+
+            for (std::uint32_t hit = outputs[state] >= 0 ? state : dictionary[state]; hit != Missing; hit = dictionary[hit])
+            {
+                std::int32_t index = outputs[hit];
+                size_t start = i + 1 - patterns[index].length();
+                std::int32_t& slot = longest[start % maxLength];
+
+                if (slot < 0 || patterns[slot].length() < patterns[index].length())
+                    slot = index;
+            }
+
+            if (i + 1 >= maxLength)
+                settle(i + 1 - maxLength);
+        }
+
+        size_t first = source.length() >= maxLength ? source.length() - maxLength + 1 : 0;
+
+        for (size_t start = first; start < source.length(); ++start)
+            settle(start);
+    }
+
+    std::vector<string_type> patterns;
+    std::vector<string_type> replacements;
+
+    std::vector<std::uint32_t> alphabet;
+    std::uint32_t byteClasses[256];
+    size_t classes = 1;
+    size_t maxLength = 0;
+
+    std::vector<std::uint32_t> transitions;
+    std::vector<std::int32_t> outputs;
+    std::vector<std::uint32_t> dictionary;
+
+};
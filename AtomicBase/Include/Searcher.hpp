@@ -0,0 +1,266 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include "SimdSupport.hpp"
+
+template <typename T>
+class Searcher
+{
+    static_assert(
+        std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+        std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+        "T only supports char, wchar_t, char16_t, and char32_t types."
+        );
+
+public:
+
+    using string_type = std::basic_string<T>;
+    using view_type = std::basic_string_view<T>;
+
+    static constexpr size_t npos = view_type::npos;
+    static constexpr size_t VectorNeedleLimit = 32;
+
+    explicit Searcher(view_type pattern) : needle(pattern)
+    {
+        if (pattern.length() <= VectorNeedleLimit)
+            return;
+
+        shifts.fill(pattern.length());
+
+        for (size_t i = 0; i + 1 < pattern.length(); ++i)
+            shifts[Hash(pattern[i])] = pattern.length() - 1 - i;
+    }
+
+    view_type Needle() const
+    {
+        return needle;
+    }
+
+    size_t Find(view_type haystack, size_t from = 0) const
+    {
+        size_t m = needle.length();
+
+        if (from > haystack.length())
+            return npos;
+
+        if (m == 0)
+            return from;
+
+        if (m > haystack.length() - from)
+            return npos;
+
+        size_t found = m <= VectorNeedleLimit ? FindShort(haystack.data() + from, haystack.length() - from) : FindLong(haystack.data() + from, haystack.length() - from);
+
+        return found == npos ? npos : found + from;
+    }
+
+    bool Contains(view_type haystack) const
+    {
+        return Find(haystack) != npos;
+    }
+
+    size_t Count(view_type haystack) const
+    {
+        size_t count = 0;
+
+        if (needle.empty())
+            return count;
+
+        for (size_t pos = Find(haystack); pos != npos; pos = Find(haystack, pos + needle.length()))
+            ++count;
+
+        return count;
+    }
+
+    std::vector<size_t> FindAll(view_type haystack) const
+    {
+        std::vector<size_t> positions;
+
+        if (needle.empty())
+            return positions;
+
+        for (size_t pos = Find(haystack); pos != npos; pos = Find(haystack, pos + needle.length()))
+            positions.push_back(pos);
+
+        return positions;
+    }
+
+private:
+
+    static size_t Hash(T c)
+    {
+        return static_cast<size_t>(static_cast<std::make_unsigned_t<T>>(c)) & 0xFF;
+    }
+
+    bool MatchesAt(const T* data) const
+    {
+        return std::memcmp(data, needle.data(), needle.length() * sizeof(T)) == 0;
+    }
+
+    size_t FindShort(const T* data, size_t length) const
+    {
+        size_t i = 0;
+
+#if defined(ATOMICBASE_SSE2)
+        size_t found;
+
+        if (CpuFeatures::HasAvx2())
+            found = FindAvx2(data, length, i);
+        else
+            found = FindSse2(data, length, i);
+
+        if (found != npos)
+            return found;
+#endif
+
+        for (; i + needle.length() <= length; ++i)
+        {
+            if (data[i] == needle[0] && MatchesAt(data + i))
+                return i;
+        }
+
+        return npos;
+    }
+
+    size_t FindLong(const T* data, size_t length) const
+    {
+        size_t m = needle.length();
+        T last = needle[m - 1];
+
+        for (size_t i = 0; i + m <= length; )
+        {
+            T unit = data[i + m - 1];
+
+            if (unit == last && std::memcmp(data + i, needle.data(), (m - 1) * sizeof(T)) == 0)
+                return i;
+
+            i += shifts[Hash(unit)];
+        }
+
+        return npos;
+    }
+
+#if defined(ATOMICBASE_SSE2)
+
+    static __m128i Splat(T c)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm_set1_epi8(static_cast<char>(c));
+        else if constexpr (sizeof(T) == 2)
+            return _mm_set1_epi16(static_cast<short>(c));
+        else
+            return _mm_set1_epi32(static_cast<int>(c));
+    }
+
+    static __m128i Equal(__m128i lhs, __m128i rhs)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm_cmpeq_epi8(lhs, rhs);
+        else if constexpr (sizeof(T) == 2)
+            return _mm_cmpeq_epi16(lhs, rhs);
+        else
+            return _mm_cmpeq_epi32(lhs, rhs);
+    }
+
+    size_t FindSse2(const T* data, size_t length, size_t& done) const
+    {
+        constexpr size_t Lanes = sizeof(__m128i) / sizeof(T);
+        constexpr unsigned LaneMask = (1u << sizeof(T)) - 1;
+
+        size_t m = needle.length();
+
+        const __m128i first = Splat(needle[0]);
+        const __m128i last = Splat(needle[m - 1]);
+
+        size_t i = 0;
+
+        for (; i + m - 1 + Lanes <= length; i += Lanes)
+        {
+            __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + m - 1));
+            unsigned candidates = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(Equal(head, first), Equal(tail, last))));
+
+            while (candidates != 0)
+            {
+                unsigned bit = CpuFeatures::CountTrailingZeros(candidates);
+                size_t position = i + bit / sizeof(T);
+
+                if (MatchesAt(data + position))
+                    return position;
+
+                candidates &= ~(LaneMask << bit);
+            }
+        }
+
+        done = i;
+
+        return npos;
+    }
+
+    ATOMICBASE_TARGET_AVX2 static __m256i Splat256(T c)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm256_set1_epi8(static_cast<char>(c));
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_set1_epi16(static_cast<short>(c));
+        else
+            return _mm256_set1_epi32(static_cast<int>(c));
+    }
+
+    ATOMICBASE_TARGET_AVX2 static __m256i Equal256(__m256i lhs, __m256i rhs)
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm256_cmpeq_epi8(lhs, rhs);
+        else if constexpr (sizeof(T) == 2)
+            return _mm256_cmpeq_epi16(lhs, rhs);
+        else
+            return _mm256_cmpeq_epi32(lhs, rhs);
+    }
+
+    ATOMICBASE_TARGET_AVX2 size_t FindAvx2(const T* data, size_t length, size_t& done) const
+    {
+        constexpr size_t Lanes = sizeof(__m256i) / sizeof(T);
+        constexpr unsigned LaneMask = (1u << sizeof(T)) - 1;
+
+        size_t m = needle.length();
+
+        const __m256i first = Splat256(needle[0]);
+        const __m256i last = Splat256(needle[m - 1]);
+
+        size_t i = 0;
+
+        for (; i + m - 1 + Lanes <= length; i += Lanes)
+        {
+            __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + m - 1));
+            unsigned candidates = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(Equal256(head, first), Equal256(tail, last))));
+
+            while (candidates != 0)
+            {
+                unsigned bit = CpuFeatures::CountTrailingZeros(candidates);
+                size_t position = i + bit / sizeof(T);
+
+                if (MatchesAt(data + position))
+                    return position;
+
+                candidates &= ~(LaneMask << bit);
+            }
+        }
+
+        done = i;
+
+        return npos;
+    }
+
+#endif
+
+    string_type needle;
+    std::array<size_t, 256> shifts;
+
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define ATOMICBASE_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if defined(ATOMICBASE_SSE2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(ATOMICBASE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define ATOMICBASE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ATOMICBASE_TARGET_AVX2
+#endif
+
+class CpuFeatures
+{
+
+public:
+
+    static bool HasAvx2()
+    {
+        static const bool supported = DetectAvx2();
+        return supported;
+    }
+
+    static unsigned CountTrailingZeros(unsigned mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+private:
+
+    static bool DetectAvx2()
+    {
+#if defined(ATOMICBASE_SSE2) && defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+
+        __cpuid(info, 0);
+
+        if (info[0] < 7)
+            return false;
+
+        __cpuid(info, 1);
+
+        bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+        __cpuidex(info, 7, 0);
+
+        return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#elif defined(ATOMICBASE_SSE2)
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <memory_resource>
+#include <cstddef>
+
+class StringResource
+{
+
+public:
+
+    static constexpr size_t LargestPooledBlock = 4096;
+    static constexpr size_t MaxBlocksPerChunk = 128;
+
+    static std::pmr::pool_options Options()
+    {
+        std::pmr::pool_options options;
+
+        options.largest_required_pool_block = LargestPooledBlock;
+        options.max_blocks_per_chunk = MaxBlocksPerChunk;
+
+        return options;
+    }
+
+    static std::pmr::memory_resource* ThreadLocal()
+    {
+        thread_local std::pmr::unsynchronized_pool_resource pool(Options());
+        return &pool;
+    }
+
+    static std::pmr::memory_resource* Shared()
+    {
+        static std::pmr::synchronized_pool_resource pool(Options());
+        return &pool;
+    }
+
+};
+
+template <size_t InlineBytes = 4096>
+class StringArena
+{
+
+public:
+
+    StringArena() : StringArena(StringResource::ThreadLocal()) {}
+
+    explicit StringArena(std::pmr::memory_resource* upstream) : resource(buffer, InlineBytes, upstream) {}
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::pmr::memory_resource* Resource()
+    {
+        return &resource;
+    }
+
+    void Release()
+    {
+        resource.release();
+    }
+
+private:
+
+    alignas(std::max_align_t) std::byte buffer[InlineBytes];
+    std::pmr::monotonic_buffer_resource resource;
+
+};
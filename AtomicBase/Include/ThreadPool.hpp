@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <exception>
+#include <type_traits>
+#include <cstddef>
+
+class ThreadPool
+{
+
+public:
+
+    explicit ThreadPool(size_t workerCount)
+    {
+        for (size_t i = 0; i < workerCount; ++i)
+            queues.push_back(std::make_unique<Queue>());
+
+        for (size_t i = 0; i < workerCount; ++i)
+            workers.emplace_back([this, i] { Work(i); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+
+        wake.notify_all();
+
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    static ThreadPool& Instance()
+    {
+        static ThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+        return pool;
+    }
+
+    size_t Concurrency() const
+    {
+        return workers.size() + 1;
+    }
+
+    template <typename F>
+    void ParallelFor(size_t count, F&& body)
+    {
+        if (count == 0)
+            return;
+
+        if (count == 1 || workers.empty())
+        {
+            for (size_t i = 0; i < count; ++i)
+                body(i);
+
+            return;
+        }
+
+        using body_type = std::remove_reference_t<F>;
+
+        struct BoundJob : Job
+        {
+            body_type* body;
+        };
+
+        BoundJob job;
+
+        job.remaining.store(count, std::memory_order_relaxed);
+        job.body = &body;
+        job.run = [](Job* erased, size_t index) { (*static_cast<BoundJob*>(erased)->body)(index); };
+
+        pending.fetch_add(count, std::memory_order_release);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            Queue& queue = *queues[next.fetch_add(1, std::memory_order_relaxed) % queues.size()];
+
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back({ &job, i });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+        }
+
+        wake.notify_all();
+
+        Task task;
+
+        while (job.remaining.load(std::memory_order_acquire) != 0 && TrySteal(0, task))
+            Execute(task);
+
+        {
+            std::unique_lock<std::mutex> lock(job.mutex);
+            job.done.wait(lock, [&job] { return job.finished; });
+        }
+
+        if (job.error)
+            std::rethrow_exception(job.error);
+    }
+
+private:
+
+    struct Job
+    {
+        void (*run)(Job*, size_t) = nullptr;
+        std::atomic<size_t> remaining = 0;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable done;
+        bool finished = false;
+    };
+
+    struct Task
+    {
+        Job* job = nullptr;
+        size_t index = 0;
+    };
+
+    struct alignas(64) Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool TryPop(size_t owner, Task& task)
+    {
+        Queue& queue = *queues[owner];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            return false;
+
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        pending.fetch_sub(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    bool TrySteal(size_t start, Task& task)
+    {
+        for (size_t i = 0; i < queues.size(); ++i)
+        {
+            Queue& queue = *queues[(start + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.tasks.empty())
+                continue;
+
+            task = queue.tasks.front();
+            queue.tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    static void Execute(const Task& task)
+    {
+        Job* job = task.job;
+
+        try
+        {
+            job->run(job, task.index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(job->mutex);
+
+            if (!job->error)
+                job->error = std::current_exception();
+        }
+
+        if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            std::lock_guard<std::mutex> lock(job->mutex);
+
+            job->finished = true;
+            job->done.notify_all();
+        }
+    }
+
+    void Work(size_t index)
+    {
+        Task task;
+
+        while (true)
+        {
+            if (TryPop(index, task) || TrySteal(index + 1, task))
+            {
+                Execute(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [this] { return stopping || pending.load(std::memory_order_acquire) != 0; });
+
+            if (stopping)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending = 0;
+    std::atomic<size_t> next = 0;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+};
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include "SimdSupport.hpp"
+
+class Transcoder
+{
+
+public:
+
+    enum class Encoding
+    {
+        Utf8,
+        Utf16,
+        Utf32
+    };
+
+    template <typename T>
+    static constexpr Encoding EncodingOf()
+    {
+        static_assert(
+            std::is_same<T, char>::value || std::is_same<T, wchar_t>::value ||
+            std::is_same<T, char16_t>::value || std::is_same<T, char32_t>::value,
+            "Transcoder only supports char, wchar_t, char16_t, and char32_t types."
+            );
+
+        if constexpr (sizeof(T) == 1)
+            return Encoding::Utf8;
+        else if constexpr (sizeof(T) == 2)
+            return Encoding::Utf16;
+        else
+            return Encoding::Utf32;
+    }
+
+    template <typename F, typename L>
+    static std::basic_string<L> Convert(std::basic_string_view<F> from)
+    {
+        std::basic_string<L> result(Measure<F, L>(from.data(), from.length()), L());
+
+        Write<F, L>(from.data(), from.length(), result.data());
+
+        return result;
+    }
+
+    template <typename T>
+    static bool IsValid(std::basic_string_view<T> str)
+    {
+        try
+        {
+            if constexpr (EncodingOf<T>() == Encoding::Utf8)
+                Measure<T, char32_t>(str.data(), str.length());
+            else
+                Measure<T, char>(str.data(), str.length());
+
+            return true;
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+    }
+
+    template <typename F, typename L>
+    static size_t Measure(const F* data, size_t length)
+    {
+        constexpr Encoding source = EncodingOf<F>();
+        constexpr Encoding target = EncodingOf<L>();
+
+        if constexpr (source == target)
+            return length;
+        else
+        {
+            size_t count = 0;
+            size_t i = 0;
+
+            while (i < length)
+            {
+                if (Unit(data[i]) < 0x80)
+                {
+                    size_t run = AsciiPrefix(data + i, length - i);
+
+                    count += run;
+                    i += run;
+
+                    continue;
+                }
+
+                char32_t codePoint;
+
+                i += Decode<source>(data + i, length - i, codePoint);
+                count += EncodedLength<target>(codePoint);
+            }
+
+            return count;
+        }
+    }
+
+    template <typename F, typename L>
+    static L* Write(const F* data, size_t length, L* out)
+    {
+        constexpr Encoding source = EncodingOf<F>();
+        constexpr Encoding target = EncodingOf<L>();
+
+        if constexpr (source == target)
+        {
+            for (size_t i = 0; i < length; ++i)
+                out[i] = static_cast<L>(data[i]);
+
+            return out + length;
+        }
+        else
+        {
+            size_t i = 0;
+
+            while (i < length)
+            {
+                if (Unit(data[i]) < 0x80)
+                {
+                    size_t run = AsciiPrefix(data + i, length - i);
+
+                    CopyAscii(data + i, run, out);
+
+                    out += run;
+                    i += run;
+
+                    continue;
+                }
+
+                char32_t codePoint;
+
+                i += Decode<source>(data + i, length - i, codePoint);
+                out = Encode<target>(codePoint, out);
+            }
+
+            return out;
+        }
+    }
+
+    template <typename T>
+    static size_t AsciiPrefix(const T* data, size_t length)
+    {
+        size_t i = 0;
+
+#if defined(ATOMICBASE_SSE2)
+        if (CpuFeatures::HasAvx2())
+            i = AsciiPrefixAvx2(data, length);
+        else
+            i = AsciiPrefixSse2(data, length);
+#endif
+
+        while (i < length && Unit(data[i]) < 0x80)
+            ++i;
+
+        return i;
+    }
+
+    template <typename T>
+    static bool IsLeadingUnit(T unit)
+    {
+        constexpr Encoding encoding = EncodingOf<T>();
+
+        if constexpr (encoding == Encoding::Utf8)
+            return (Unit(unit) & 0xC0) != 0x80;
+        else if constexpr (encoding == Encoding::Utf16)
+            return Unit(unit) < 0xDC00 || Unit(unit) > 0xDFFF;
+        else
+            return true;
+    }
+
+private:
+
+    template <typename T>
+    static std::uint32_t Unit(T c)
+    {
+        return static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<T>>(c));
+    }
+
+    template <Encoding E, typename T>
+    static size_t Decode(const T* data, size_t length, char32_t& codePoint)
+    {
+        std::uint32_t lead = Unit(data[0]);
+
+        if constexpr (E == Encoding::Utf8)
+        {
+            size_t size;
+            std::uint32_t minimum;
+
+            if (lead < 0x80)
+            {
+                codePoint = lead;
+                return 1;
+            }
+            else if (lead >= 0xC2 && lead <= 0xDF)
+            {
+                size = 2;
+                minimum = 0x80;
+                codePoint = lead & 0x1F;
+            }
+            else if (lead >= 0xE0 && lead <= 0xEF)
+            {
+                size = 3;
+                minimum = 0x800;
+                codePoint = lead & 0x0F;
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+            {
+                size = 4;
+                minimum = 0x10000;
+                codePoint = lead & 0x07;
+            }
+            else
+                throw std::runtime_error("Invalid UTF-8 sequence.");
+
+            if (length < size)
+                throw std::runtime_error("Truncated UTF-8 sequence.");
+
+            for (size_t i = 1; i < size; ++i)
+            {
+                std::uint32_t unit = Unit(data[i]);
+
+                if ((unit & 0xC0) != 0x80)
+                    throw std::runtime_error("Invalid UTF-8 sequence.");
+
+                codePoint = (codePoint << 6) | (unit & 0x3F);
+            }
+
+            if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+                throw std::runtime_error("Invalid UTF-8 sequence.");
+
+            return size;
+        }
+        else if constexpr (E == Encoding::Utf16)
+        {
+            if (lead < 0xD800 || lead > 0xDFFF)
+            {
+                codePoint = lead;
+                return 1;
+            }
+
+            if (lead > 0xDBFF || length < 2 || Unit(data[1]) < 0xDC00 || Unit(data[1]) > 0xDFFF)
+                throw std::runtime_error("Invalid UTF-16 sequence.");
+
+            codePoint = 0x10000 + ((lead - 0xD800) << 10) + (Unit(data[1]) - 0xDC00);
+            return 2;
+        }
+        else
+        {
+            if (lead > 0x10FFFF || (lead >= 0xD800 && lead <= 0xDFFF))
+                throw std::runtime_error("Invalid UTF-32 code point.");
+
+            codePoint = lead;
+            return 1;
+        }
+    }
+
+    template <Encoding E>
+    static size_t EncodedLength(char32_t codePoint)
+    {
+        if constexpr (E == Encoding::Utf8)
+            return codePoint < 0x80 ? 1 : (codePoint < 0x800 ? 2 : (codePoint < 0x10000 ? 3 : 4));
+        else if constexpr (E == Encoding::Utf16)
+            return codePoint < 0x10000 ? 1 : 2;
+        else
+            return 1;
+    }
+
+    template <Encoding E, typename L>
+    static L* Encode(char32_t codePoint, L* out)
+    {
+        if constexpr (E == Encoding::Utf8)
+        {
+            if (codePoint < 0x80)
+                *out++ = static_cast<L>(codePoint);
+            else if (codePoint < 0x800)
+            {
+                *out++ = static_cast<L>(0xC0 | (codePoint >> 6));
+                *out++ = static_cast<L>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *out++ = static_cast<L>(0xE0 | (codePoint >> 12));
+                *out++ = static_cast<L>(0x80 | ((codePoint >> 6) & 0x3F));
+                *out++ = static_cast<L>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *out++ = static_cast<L>(0xF0 | (codePoint >> 18));
+                *out++ = static_cast<L>(0x80 | ((codePoint >> 12) & 0x3F));
+                *out++ = static_cast<L>(0x80 | ((codePoint >> 6) & 0x3F));
+                *out++ = static_cast<L>(0x80 | (codePoint & 0x3F));
+            }
+        }
+        else if constexpr (E == Encoding::Utf16)
+        {
+            if (codePoint < 0x10000)
+                *out++ = static_cast<L>(codePoint);
+            else
+            {
+                *out++ = static_cast<L>(0xD800 + ((codePoint - 0x10000) >> 10));
+                *out++ = static_cast<L>(0xDC00 + ((codePoint - 0x10000) & 0x3FF));
+            }
+        }
+        else
+            *out++ = static_cast<L>(codePoint);
+
+        return out;
+    }
+
+    template <typename F, typename L>
+    static void CopyAscii(const F* data, size_t length, L* out)
+    {
+        size_t i = 0;
+
+#if defined(ATOMICBASE_SSE2)
+        constexpr size_t Lanes = sizeof(__m128i) / (sizeof(F) < sizeof(L) ? sizeof(F) : sizeof(L));
+
+        for (; i + Lanes <= length; i += Lanes)
+            CopyAsciiBlock(data + i, out + i);
+#endif
+
+        for (; i < length; ++i)
+            out[i] = static_cast<L>(data[i]);
+    }
+
+#if defined(ATOMICBASE_SSE2)
+
+    template <typename F, typename L>
+    static void CopyAsciiBlock(const F* data, L* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+
+        if constexpr (sizeof(F) == 1 && sizeof(L) == 2)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(block, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(block, zero));
+        }
+        else if constexpr (sizeof(F) == 1 && sizeof(L) == 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i low = _mm_unpacklo_epi8(block, zero);
+            __m128i high = _mm_unpackhi_epi8(block, zero);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(low, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(low, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(high, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(high, zero));
+        }
+        else if constexpr (sizeof(F) == 2 && sizeof(L) == 1)
+        {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 8));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(low, high));
+        }
+        else if constexpr (sizeof(F) == 2 && sizeof(L) == 4)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi16(block, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(block, zero));
+        }
+        else if constexpr (sizeof(F) == 4 && sizeof(L) == 1)
+        {
+            __m128i first = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 4)));
+            __m128i second = _mm_packs_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 8)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 12)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(first, second));
+        }
+        else
+        {
+            __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+            __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 4));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(low, high));
+        }
+    }
+
+    template <typename T>
+    static __m128i HighBits()
+    {
+        if constexpr (sizeof(T) == 1)
+            return _mm_set1_epi8(static_cast<char>(0x80));
+        else if constexpr (sizeof(T) == 2)
+            return _mm_set1_epi16(static_cast<short>(0xFF80));
+        else
+            return _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+    }
+
+    template <typename T>
+    static size_t AsciiPrefixSse2(const T* data, size_t length)
+    {
+        constexpr size_t Lanes = sizeof(__m128i) / sizeof(T);
+
+        const __m128i high = HighBits<T>();
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t i = 0;
+
+        for (; i + Lanes <= length; i += Lanes)
+        {
+            __m128i block = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), high);
+            unsigned ascii = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, zero)));
+
+            if (ascii != 0xFFFF)
+                return i + CpuFeatures::CountTrailingZeros(~ascii) / sizeof(T);
+        }
+
+        return i;
+    }
+
+    template <typename T>
+    ATOMICBASE_TARGET_AVX2 static size_t AsciiPrefixAvx2(const T* data, size_t length)
+    {
+        constexpr size_t Lanes = sizeof(__m256i) / sizeof(T);
+
+        __m256i high;
+
+        if constexpr (sizeof(T) == 1)
+            high = _mm256_set1_epi8(static_cast<char>(0x80));
+        else if constexpr (sizeof(T) == 2)
+            high = _mm256_set1_epi16(static_cast<short>(0xFF80));
+        else
+            high = _mm256_set1_epi32(static_cast<int>(0xFFFFFF80));
+
+        const __m256i zero = _mm256_setzero_si256();
+
+        size_t i = 0;
+
+        for (; i + Lanes <= length; i += Lanes)
+        {
+            __m256i block = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), high);
+            unsigned ascii = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, zero)));
+
+            if (ascii != 0xFFFFFFFFu)
+                return i + CpuFeatures::CountTrailingZeros(~ascii) / sizeof(T);
+        }
+
+        return i;
+    }
+
+#endif
+
+};
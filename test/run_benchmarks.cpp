@@ -0,0 +1,557 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AtomicString.hpp"
+
+using bench_clock = std::chrono::steady_clock;
+
+constexpr size_t MaxIterateSize = 64 * 1024;
+constexpr size_t MaxConvertSize = 16 * 1024 * 1024;
+
+struct Options
+{
+	std::vector<size_t> sizes{ 8, 1024, 64 * 1024, 1024 * 1024, 100 * 1000 * 1000 };
+	std::vector<double> readRatios{ 1.0, 0.99, 0.9, 0.5, 0.0 };
+	size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	std::chrono::milliseconds duration{ 250 };
+	std::string output;
+};
+
+struct Result
+{
+	std::string subject;
+	std::string operation;
+	size_t threads = 0;
+	size_t size = 0;
+	double readRatio = 0.0;
+	uint64_t operations = 0;
+	double opsPerSecond = 0.0;
+	uint64_t p50 = 0;
+	uint64_t p99 = 0;
+	uint64_t p999 = 0;
+};
+
+enum class Operation
+{
+	Read,
+	Append,
+	Replace,
+	ToUpper,
+	Convert,
+	Iterate,
+	Mixed
+};
+
+Operation parse_operation(const std::string& name)
+{
+	if (name == "read")
+		return Operation::Read;
+	if (name == "append")
+		return Operation::Append;
+	if (name == "replace")
+		return Operation::Replace;
+	if (name == "to_upper")
+		return Operation::ToUpper;
+	if (name == "convert")
+		return Operation::Convert;
+	if (name == "iterate")
+		return Operation::Iterate;
+	if (name == "mixed")
+		return Operation::Mixed;
+
+	throw std::runtime_error("Unknown operation " + name);
+}
+
+// Log-linear latency histogram: 16 sub-buckets per power of two, so every
+// sample of a run is kept at a relative error of at most 1/16.
+class LatencyHistogram
+{
+
+public:
+
+	void Record(uint64_t nanoseconds)
+	{
+		++buckets[BucketOf(nanoseconds)];
+	}
+
+	void Merge(const LatencyHistogram& other)
+	{
+		for (size_t i = 0; i < BucketCount; ++i)
+			buckets[i] += other.buckets[i];
+	}
+
+	uint64_t Percentile(double fraction) const
+	{
+		uint64_t total = 0;
+
+		for (uint64_t count : buckets)
+			total += count;
+
+		if (total == 0)
+			return 0;
+
+		uint64_t rank = std::min(total - 1, static_cast<uint64_t>(fraction * static_cast<double>(total)));
+		uint64_t seen = 0;
+
+		for (size_t i = 0; i < BucketCount; ++i)
+		{
+			seen += buckets[i];
+
+			if (seen > rank)
+				return UpperBound(i);
+		}
+
+		return UpperBound(BucketCount - 1);
+	}
+
+private:
+
+	static constexpr size_t SubBucketBits = 4;
+	static constexpr size_t SubBuckets = size_t(1) << SubBucketBits;
+	static constexpr size_t BucketCount = (64 - SubBucketBits + 1) * SubBuckets;
+
+	static size_t BucketOf(uint64_t value)
+	{
+		if (value < SubBuckets)
+			return static_cast<size_t>(value);
+
+		size_t exponent = std::bit_width(value) - 1;
+		size_t sub = static_cast<size_t>(value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+
+		return (exponent - SubBucketBits + 1) * SubBuckets + sub;
+	}
+
+	static uint64_t UpperBound(size_t bucket)
+	{
+		if (bucket < SubBuckets)
+			return bucket;
+
+		size_t group = bucket / SubBuckets;
+		uint64_t lower = (SubBuckets + bucket % SubBuckets) << (group - 1);
+
+		return lower + (uint64_t(1) << (group - 1)) - 1;
+	}
+
+	std::array<uint64_t, BucketCount> buckets{};
+
+};
+
+std::string make_payload(size_t size)
+{
+	std::string payload(size, 'a');
+
+	for (size_t i = 0; i < size; ++i)
+		payload[i] = static_cast<char>('a' + i % 23);
+
+	return payload;
+}
+
+template <typename LockPolicy>
+class AtomicSubject
+{
+
+public:
+
+	static constexpr const char* Name = "AtomicString";
+
+	explicit AtomicSubject(const std::string& payload) : str(payload), limit(payload.size() * 2 + 64), base(payload.size()) {}
+
+	size_t Read()
+	{
+		return str.Contains(std::string("~~"));
+	}
+
+	size_t Append()
+	{
+		str += "01234567";
+
+		if (str.Length() > limit)
+			str.Modify([this](std::string& data) { data.resize(base); });
+
+		return 1;
+	}
+
+	size_t Replace()
+	{
+		str.FindAndReplace(std::string("abc"), std::string("abc"));
+		return 1;
+	}
+
+	size_t Upper(bool upper)
+	{
+		if (upper)
+			str.ToUpper();
+		else
+			str.ToLower();
+
+		return 1;
+	}
+
+	size_t Convert()
+	{
+		return str.operator std::u16string().size();
+	}
+
+	size_t Iterate()
+	{
+		size_t sum = 0;
+
+		for (auto it = str.begin(); it != str.end(); ++it)
+			sum += static_cast<unsigned char>(*it);
+
+		return sum;
+	}
+
+private:
+
+	AtomicString<char, LockPolicy> str;
+	size_t limit;
+	size_t base;
+
+};
+
+class DistributedSubject : public AtomicSubject<DistributedLockPolicy>
+{
+
+public:
+
+	static constexpr const char* Name = "AtomicString<DistributedLockPolicy>";
+
+	using AtomicSubject::AtomicSubject;
+
+};
+
+class MutexSubject
+{
+
+public:
+
+	static constexpr const char* Name = "std::string+std::mutex";
+
+	explicit MutexSubject(const std::string& payload) : str(payload), limit(payload.size() * 2 + 64), base(payload.size()) {}
+
+	size_t Read()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return str.find("~~") != std::string::npos;
+	}
+
+	size_t Append()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		str += "01234567";
+
+		if (str.size() > limit)
+			str.resize(base);
+
+		return 1;
+	}
+
+	size_t Replace()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		std::string result;
+		size_t start = 0;
+
+		result.reserve(str.size());
+
+		for (size_t pos = str.find("abc"); pos != std::string::npos; pos = str.find("abc", start))
+		{
+			result.append(str, start, pos - start).append("abc");
+			start = pos + 3;
+		}
+
+		result.append(str, start);
+		str = std::move(result);
+
+		return 1;
+	}
+
+	size_t Upper(bool upper)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		for (char& c : str)
+			c = static_cast<char>(upper ? std::toupper(static_cast<unsigned char>(c)) : std::tolower(static_cast<unsigned char>(c)));
+
+		return 1;
+	}
+
+	size_t Convert()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return Transcoder::Convert<char, char16_t>(str).size();
+	}
+
+	size_t Iterate()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		size_t sum = 0;
+
+		for (auto it = str.begin(); it != str.end(); ++it)
+			sum += static_cast<unsigned char>(*it);
+
+		return sum;
+	}
+
+private:
+
+	std::mutex mutex;
+	std::string str;
+	size_t limit;
+	size_t base;
+
+};
+
+template <typename Subject>
+Result run_case(const std::string& operation, const std::string& payload, size_t threads, double readRatio, const Options& options)
+{
+	Subject subject(payload);
+	Operation resolved = parse_operation(operation);
+
+	std::atomic<bool> start = false;
+	std::atomic<bool> stop = false;
+	std::atomic<size_t> sink = 0;
+	std::vector<uint64_t> counts(threads, 0);
+	std::vector<LatencyHistogram> latencies(threads);
+	std::vector<std::thread> workers;
+
+	for (size_t t = 0; t < threads; ++t)
+	{
+		workers.emplace_back([&, t]
+		{
+			uint64_t state = 0x9E3779B97F4A7C15ull * (t + 1);
+			uint64_t done = 0;
+			size_t local = 0;
+
+			LatencyHistogram histogram;
+
+			while (!start.load(std::memory_order_acquire))
+				std::this_thread::yield();
+
+			do
+			{
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+
+				Operation step = resolved;
+
+				if (step == Operation::Mixed)
+					step = static_cast<double>(state % 10000) < readRatio * 10000.0 ? Operation::Read : Operation::Append;
+
+				auto begin = bench_clock::now();
+
+				switch (step)
+				{
+				case Operation::Read:
+					local += subject.Read();
+					break;
+				case Operation::Append:
+					local += subject.Append();
+					break;
+				case Operation::Replace:
+					local += subject.Replace();
+					break;
+				case Operation::ToUpper:
+					local += subject.Upper(done % 2 == 0);
+					break;
+				case Operation::Convert:
+					local += subject.Convert();
+					break;
+				case Operation::Iterate:
+					local += subject.Iterate();
+					break;
+				default:
+					break;
+				}
+
+				auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - begin).count();
+
+				histogram.Record(static_cast<uint64_t>(elapsed));
+
+				++done;
+			}
+			while (!stop.load(std::memory_order_relaxed));
+
+			counts[t] = done;
+			latencies[t] = histogram;
+			sink.fetch_add(local, std::memory_order_relaxed);
+		});
+	}
+
+	auto begin = bench_clock::now();
+
+	start.store(true, std::memory_order_release);
+	std::this_thread::sleep_for(options.duration);
+	stop.store(true, std::memory_order_relaxed);
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	double seconds = std::chrono::duration<double>(bench_clock::now() - begin).count();
+
+	LatencyHistogram merged;
+
+	for (const LatencyHistogram& histogram : latencies)
+		merged.Merge(histogram);
+
+	Result result;
+
+	result.subject = Subject::Name;
+	result.operation = operation;
+	result.threads = threads;
+	result.size = payload.size();
+	result.readRatio = readRatio;
+
+	for (uint64_t count : counts)
+		result.operations += count;
+
+	result.opsPerSecond = static_cast<double>(result.operations) / seconds;
+	result.p50 = merged.Percentile(0.50);
+	result.p99 = merged.Percentile(0.99);
+	result.p999 = merged.Percentile(0.999);
+
+	return result;
+}
+
+void write_json(std::ostream& stream, const std::vector<Result>& results)
+{
+	stream << "{\n";
+	stream << "  \"library\": \"AtomicBase\",\n";
+	stream << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+	stream << "  \"timestamp\": " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count() << ",\n";
+	stream << "  \"results\": [\n";
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const Result& result = results[i];
+
+		stream << "    { \"subject\": \"" << result.subject << "\", \"operation\": \"" << result.operation << "\"";
+		stream << ", \"threads\": " << result.threads << ", \"size\": " << result.size << ", \"read_ratio\": " << result.readRatio;
+		stream << ", \"operations\": " << result.operations << ", \"ops_per_sec\": " << static_cast<uint64_t>(result.opsPerSecond);
+		stream << ", \"p50_ns\": " << result.p50 << ", \"p99_ns\": " << result.p99 << ", \"p999_ns\": " << result.p999 << " }";
+		stream << (i + 1 < results.size() ? ",\n" : "\n");
+	}
+
+	stream << "  ]\n";
+	stream << "}\n";
+}
+
+std::vector<size_t> parse_list(const std::string& text)
+{
+	std::vector<size_t> values;
+	std::stringstream stream(text);
+	std::string item;
+
+	while (std::getline(stream, item, ','))
+		values.push_back(static_cast<size_t>(std::stoull(item)));
+
+	return values;
+}
+
+Options parse_options(int argc, char** argv)
+{
+	Options options;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+		std::string value = i + 1 < argc ? argv[i + 1] : "";
+
+		if (argument == "--quick")
+		{
+			options.sizes = { 8, 1024, 64 * 1024 };
+			options.readRatios = { 1.0, 0.9, 0.5 };
+			options.duration = std::chrono::milliseconds(50);
+			continue;
+		}
+
+		if (value.empty())
+			throw std::runtime_error("Missing value for " + argument);
+
+		if (argument == "--sizes")
+			options.sizes = parse_list(value);
+		else if (argument == "--threads")
+			options.maxThreads = std::max<size_t>(1, std::stoull(value));
+		else if (argument == "--duration-ms")
+			options.duration = std::chrono::milliseconds(std::stoll(value));
+		else if (argument == "--output")
+			options.output = value;
+		else
+			throw std::runtime_error("Unknown argument " + argument);
+
+		++i;
+	}
+
+	return options;
+}
+
+template <typename Subject>
+void run_subject(const Options& options, std::vector<Result>& results)
+{
+	const std::vector<std::string> operations{ "read", "append", "replace", "to_upper", "convert", "iterate" };
+
+	for (size_t size : options.sizes)
+	{
+		std::string payload = make_payload(size);
+
+		for (size_t threads = 1; threads <= options.maxThreads; threads = threads * 2 > options.maxThreads && threads != options.maxThreads ? options.maxThreads : threads * 2)
+		{
+			for (const std::string& operation : operations)
+			{
+				if ((operation == "iterate" && size > MaxIterateSize) || (operation == "convert" && size > MaxConvertSize))
+					continue;
+
+				results.push_back(run_case<Subject>(operation, payload, threads, operation == "read" ? 1.0 : 0.0, options));
+				std::cerr << Subject::Name << ' ' << operation << " size=" << size << " threads=" << threads << " ops/s=" << static_cast<uint64_t>(results.back().opsPerSecond) << std::endl;
+			}
+
+			for (double ratio : options.readRatios)
+				results.push_back(run_case<Subject>("mixed", payload, threads, ratio, options));
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		Options options = parse_options(argc, argv);
+		std::vector<Result> results;
+
+		run_subject<AtomicSubject<SharedMutexLockPolicy>>(options, results);
+		run_subject<DistributedSubject>(options, results);
+		run_subject<MutexSubject>(options, results);
+
+		if (options.output.empty())
+			write_json(std::cout, results);
+		else
+		{
+			std::ofstream file(options.output);
+			write_json(file, results);
+		}
+	}
+	catch (const std::exception& error)
+	{
+		std::cerr << "Benchmark failed: " << error.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
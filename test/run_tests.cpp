@@ -1,9 +1,36 @@
 #include <chrono>
 #include <iostream>
 #include <thread>
+#include <atomic>
+#include <vector>
+#include <cctype>
+#include <algorithm>
+#include <unordered_map>
+#include <mutex>
+#include <fstream>
+#include <filesystem>
+#include <coroutine>
 #include "AtomicString.hpp"
+#include "AtomicSnapshotString.hpp"
+#include "AtomicRope.hpp"
+#include "AtomicSmallString.hpp"
+#include "InternedString.hpp"
+#include "ConcurrentStringMap.hpp"
+#include "AtomicStringBuilder.hpp"
 
 using AStr = AtomicString<char>;
+using ASnapStr = AtomicSnapshotString<char>;
+using ARope = AtomicRope<char>;
+
+int mismatches = 0;
+
+void check(const char* what, bool matches)
+{
+	std::cout << "  " << what << (matches ? ": matches reference" : ": MISMATCH") << std::endl;
+
+	if (!matches)
+		++mismatches;
+}
 
 void lower_modify(AStr& astr)
 {
@@ -67,6 +94,83 @@ void to_nines(AStr& astr)
 	std::cout << buffer.str();
 }
 
+void snapshot_read(ASnapStr& astr, bool& uniform)
+{
+	std::ostringstream buffer;
+
+	for (int i = 0; i < 15; ++i)
+	{
+		ASnapStr::Snapshot snapshot = astr.Load();
+		std::string_view view = snapshot.View();
+
+		bool upper = std::none_of(view.begin(), view.end(), [](char c) { return std::islower(static_cast<unsigned char>(c)) != 0; });
+		bool lower = std::none_of(view.begin(), view.end(), [](char c) { return std::isupper(static_cast<unsigned char>(c)) != 0; });
+		uniform = uniform && (upper || lower);
+
+		buffer << view << '\n';
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	std::cout << buffer.str();
+}
+
+void snapshot_modify(ASnapStr& astr)
+{
+	for (int i = 0; i < 15; ++i)
+	{
+		if (i % 2 == 0)
+			astr.ToUpper();
+		else
+			astr.ToLower();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+}
+
+void rope_edit(ARope& rope, size_t position, char fill)
+{
+	for (int i = 0; i < 15; ++i)
+	{
+		rope.Insert(position, std::string(4, fill));
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+}
+
+template <typename LockPolicy>
+bool policy_append_matches()
+{
+	AtomicString<char, LockPolicy> shared;
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < 4; ++i)
+		threads.emplace_back([&shared] { for (int k = 0; k < 2000; ++k) shared += "a"; });
+
+	for (auto& thread : threads)
+		thread.join();
+
+	return shared == std::string(8000, 'a');
+}
+
+struct DetachedTask
+{
+	struct promise_type
+	{
+		DetachedTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+DetachedTask async_append(AtomicString<char, AsyncLockPolicy>& str, std::atomic<size_t>& length)
+{
+	for (int k = 0; k < 2000; ++k)
+		co_await str.ModifyAsync([](std::string& s) { s += 'b'; });
+
+	length = co_await str.ReadAsync([](const std::string& s) { return s.length(); });
+}
+
 int main()
 {
     AtomicString<char> astr = "HELLOWORLDHOWAREYOUDOING";
@@ -94,5 +198,824 @@ int main()
 	std::cout << "... iterator test complete!  Output should be uniformly 1s or 9s. If you see parts of the original string leaking into the newly formatted one during iterator tests, that is NOT ThreadSafeIterator's fault, rather just the way std::cout handles printing." << std::endl;
 	std::cout << "std::cout is not thread-safe when accessed from multiple threads. Even if ThreadSafeIterator is managing concurrent iteration and modification safely, simultaneous calls to std::cout << astr << std::endl; from two threads can result in interleaved or partially overwritten output, which leads to visible artifacts (e.g., partial remnants like \"LDHO\")" << std::endl;
 
-	return 0;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting snapshot test ... " << std::endl;
+
+	ASnapStr snapshotStr = "helloworldhowareyoudoing";
+	bool snapshotsUniform = true;
+
+	std::thread t5{ snapshot_read, std::ref(snapshotStr), std::ref(snapshotsUniform) };
+	std::thread t6{ snapshot_modify, std::ref(snapshotStr) };
+
+	t5.join();
+	t6.join();
+
+	check("snapshots are uniformly upper or lower case", snapshotsUniform);
+
+	std::cout << "... snapshot test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting small string test ... " << std::endl;
+
+	AtomicSmallString<char> small = "hello";
+	std::string smallReference = "hello";
+
+	small += " world";
+	smallReference += " world";
+	check("inline append", small.IsInline() && small == smallReference);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		small += "abcdefgh";
+		smallReference += "abcdefgh";
+	}
+
+	small -= "o w";
+	smallReference.erase(smallReference.find("o w"), 3);
+	check("heap spill", !small.IsInline() && small == smallReference);
+
+	AtomicSmallString<char> movedInline = "short";
+	AtomicSmallString<char> movedHeap = std::string(100, 'x');
+
+	movedHeap = std::move(small);
+	movedInline = std::move(movedHeap);
+	check("move assignment", !movedInline.IsInline() && movedInline == smallReference && movedHeap.IsInline() && movedHeap == "" && small == "");
+
+	AtomicSmallString<char> torn = "a";
+	std::atomic<bool> tornDone = false;
+	bool untorn = true;
+
+	std::thread t10{ [&torn, &tornDone] { for (int i = 0; i < 20000; ++i) torn = std::string(i % 20 + 1, char('a' + i % 3)); tornDone = true; } };
+
+	while (!tornDone)
+	{
+		std::string seen = torn;
+		untorn = untorn && seen.find_first_not_of(seen[0]) == std::string::npos;
+	}
+
+	t10.join();
+
+	check("seqlock reads are never torn", untorn);
+
+	std::cout << "... small string test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting lock policy test ... " << std::endl;
+
+	check("SharedMutexLockPolicy appends", policy_append_matches<SharedMutexLockPolicy>());
+	check("SpinLockPolicy appends", policy_append_matches<SpinLockPolicy>());
+	check("AdaptiveLockPolicy appends", policy_append_matches<AdaptiveLockPolicy>());
+
+	AtomicString<char, NullLockPolicy> unlocked = "abc";
+	unlocked += "d";
+	check("NullLockPolicy single-threaded use", unlocked == "abcd");
+
+	std::cout << "... lock policy test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting Modify/Read test ... " << std::endl;
+
+	AStr edited = "Hello World";
+	std::string editedReference = "Hello World";
+
+	edited.Modify([](std::string& str) { str += "!!"; str.erase(0, 1); });
+	editedReference += "!!";
+	editedReference.erase(0, 1);
+
+	size_t editedLength = edited.Read([](const std::string& str) { return str.size(); });
+	check("Modify and Read", edited == editedReference && editedLength == editedReference.size());
+
+	AStr counted;
+	std::thread t11{ [&counted] { for (int i = 0; i < 5000; ++i) counted.Modify([](std::string& str) { str += "ab"; str.pop_back(); }); } };
+	std::thread t12{ [&counted] { for (int i = 0; i < 5000; ++i) counted.Modify([](std::string& str) { str += "ab"; str.pop_back(); }); } };
+
+	t11.join();
+	t12.join();
+
+	check("Modify is atomic", counted == std::string(10000, 'a'));
+
+	std::cout << "... Modify/Read test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting concatenation test ... " << std::endl;
+
+	AStr left = "Hello", right = " World";
+
+	AStr joined = left + std::string(" World");
+	check("AtomicString + std::string", joined == std::string("Hello") + " World");
+	check("AtomicString + literal", left + "!" == std::string("Hello!"));
+	check("AtomicString - literal", joined - "o W" == std::string("Hellorld"));
+
+	joined += std::string("!");
+	joined -= right;
+	joined += right;
+	check("compound += and -= with AtomicString", joined == "Hello! World");
+
+	std::cout << "... concatenation test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting case conversion test ... " << std::endl;
+
+	std::string printable;
+
+	for (int i = 0; i < 1000; ++i)
+		printable += static_cast<char>(32 + i % 95);
+
+	std::string upperReference = printable, lowerReference = printable;
+
+	for (char& c : upperReference)
+		c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+	for (char& c : lowerReference)
+		c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+
+	AStr cased = printable;
+
+	cased.ToUpper();
+	check("vectorized ToUpper", cased == upperReference);
+
+	cased.ToLower();
+	check("vectorized ToLower", cased == lowerReference);
+	check("EqualsIgnoreCase", cased.EqualsIgnoreCase(upperReference));
+	check("CompareIgnoreCase", cased.CompareIgnoreCase(std::string("~")) < 0 && cased.CompareIgnoreCase(std::string(" ")) > 0);
+
+	std::cout << "... case conversion test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting transcoder test ... " << std::endl;
+
+	std::u32string codepoints = U"a\u00E9\u4E2D\U0001F600";
+	std::string utf8 = Transcoder::Convert<char32_t, char>(codepoints);
+
+	check("UTF-32 to UTF-8", utf8 == "a\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80");
+	check("UTF-8 to UTF-16 to UTF-32 round trip", Transcoder::Convert<char16_t, char32_t>(Transcoder::Convert<char, char16_t>(utf8)) == codepoints);
+	check("invalid UTF-8 is rejected", !Transcoder::IsValid(std::string_view("\xC0\xAF")));
+
+	AtomicString<char32_t> transcoded(utf8);
+	check("AtomicString converting constructor", transcoded == codepoints);
+
+	std::cout << "... transcoder test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting ReplaceSet test ... " << std::endl;
+
+	ReplaceSet<char> animals({ { "cat", "feline" }, { "dog", "canine" }, { "the", "a" } });
+	check("multi-pattern Apply", animals.Apply("the cat and the dog") == "a feline and a canine");
+	check("leftmost-longest match", ReplaceSet<char>({ { "ab", "1" }, { "abc", "2" } }).Apply("abcab") == "21");
+
+	AStr pets = "the cat and the dog";
+	pets.FindAndReplace(animals);
+	check("AtomicString FindAndReplace(ReplaceSet)", pets == "a feline and a canine");
+
+	pets.FindAndReplace("a", "");
+	check("single-pattern FindAndReplace", pets == " feline nd  cnine");
+
+	std::cout << "... ReplaceSet test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting searcher test ... " << std::endl;
+
+	std::string haystack;
+
+	for (unsigned i = 0, seed = 7; i < 20000; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		haystack += "abcd"[(seed >> 16) % 4];
+	}
+
+	std::vector<std::string> needles{ "a", "abc", "dcba", haystack.substr(9000, 12), haystack.substr(15000, 48), "abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd", "e" };
+	bool searchesMatch = true;
+
+	for (const std::string& needle : needles)
+	{
+		Searcher<char> searcher(needle);
+
+		for (size_t from : { size_t(0), size_t(1), size_t(9001), haystack.size() })
+			searchesMatch = searchesMatch && searcher.Find(haystack, from) == haystack.find(needle, from);
+	}
+
+	check("Searcher::Find against std::string::find", searchesMatch);
+
+	Searcher<char> kept(haystack.substr(15000, 48));
+
+	check("Searcher keeps its own needle", kept.Find(haystack) == haystack.find(haystack.substr(15000, 48)));
+
+	AStr searched = haystack;
+	size_t cabCount = 0;
+
+	for (size_t position = haystack.find("cab"); position != std::string::npos; position = haystack.find("cab", position + 3))
+		++cabCount;
+
+	check("AtomicString Find/Contains/Count", searched.Find("cab") == haystack.find("cab") && !searched.Contains("e") && searched.Count("cab") == cabCount);
+
+	std::cout << "... searcher test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting rope test ... " << std::endl;
+
+	ARope rope = std::string(64 * ARope::ChunkSize, '.');
+
+	std::thread t7{ rope_edit, std::ref(rope), 16, 'a' };
+	std::thread t8{ rope_edit, std::ref(rope), 48 * ARope::ChunkSize, 'b' };
+
+	t7.join();
+	t8.join();
+
+	std::string flattened = rope;
+
+	check("concurrent rope inserts", rope.Length() == 64 * ARope::ChunkSize + 120 && flattened.substr(16, 60) == std::string(60, 'a') && std::count(flattened.begin(), flattened.end(), 'a') == 60 && std::count(flattened.begin(), flattened.end(), 'b') == 60 && rope.Count("aaaa") == 15);
+
+	std::cout << "... rope test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting rope append test ... " << std::endl;
+
+	ARope emptyRope;
+	emptyRope.Append(ARope());
+	check("empty rope append", emptyRope.Length() == 0 && std::string(emptyRope).empty());
+
+	emptyRope += ARope();
+	emptyRope += ARope("tail");
+	check("append into empty rope", std::string(emptyRope) == "tail");
+
+	std::cout << "... rope append test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting rope iteration test ... " << std::endl;
+
+	ARope iterated = std::string(8 * ARope::ChunkSize, '.');
+	bool onlyFill = true;
+
+	std::thread editor{ rope_edit, std::ref(iterated), 10, 'c' };
+
+	for (int pass = 0; pass < 4; ++pass)
+		for (auto it = iterated.begin(); it != iterated.end(); ++it)
+			onlyFill = onlyFill && (*it == '.' || *it == 'c');
+
+	editor.join();
+
+	check("rope iteration during in-chunk edits", onlyFill && iterated.Length() == 8 * ARope::ChunkSize + 60);
+
+	std::cout << "... rope iteration test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting thread pool test ... " << std::endl;
+
+	ThreadPool workers(3);
+	std::vector<int> visits(1000, 0);
+
+	workers.ParallelFor(visits.size(), [&visits](size_t i) { ++visits[i]; });
+	check("ParallelFor visits every index once", std::count(visits.begin(), visits.end(), 1) == 1000);
+
+	std::string bulk(1 << 20, 'a');
+
+	for (size_t i = 0; i < bulk.size(); ++i)
+		bulk[i] = "abAB-"[i * 7 % 5];
+
+	std::string bulkReference = bulk;
+
+	for (char& c : bulkReference)
+		c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+
+	AStr parallel = bulk;
+
+	parallel.ToUpper(workers);
+	check("parallel ToUpper", parallel == bulkReference);
+
+	parallel.FindAndReplace(std::string("AB"), std::string("x"), workers);
+	check("parallel FindAndReplace", parallel == ReplaceSet<char>::ReplaceAll(bulkReference, "AB", "x"));
+
+	std::cout << "... thread pool test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting locked view test ... " << std::endl;
+
+	AStr guarded(std::string(10000, 'x'));
+
+	{
+		auto guard = guarded.Write();
+
+		for (char& c : guard)
+			c = 'y';
+
+		guard.String().append("zz");
+	}
+
+	{
+		auto view = guarded.View();
+		check("WriteGuard edits through LockedView", view.Length() == 10002 && view.View() == std::string(10000, 'y') + "zz");
+	}
+
+	size_t chunkTotal = 0, chunkCount = 0;
+	guarded.ForEachChunk([&chunkTotal, &chunkCount](std::string_view chunk) { chunkTotal += chunk.size(); ++chunkCount; }, 1000);
+	check("ForEachChunk covers the string", chunkTotal == 10002 && chunkCount == 11);
+
+	std::cout << "... locked view test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting interned string test ... " << std::endl;
+
+	auto& internPool = AtomicStringPool<char>::Instance();
+	auto interned = internPool.Intern("api.example.com");
+	AStr hostname = "api.example.com";
+
+	check("equal text interns to one handle", interned == internPool.Intern(std::string("api.example.com")) && interned == internPool.Intern(hostname));
+	check("distinct text interns apart", interned != internPool.Intern("other.example.com"));
+	check("handle hash matches std::hash", interned.Hash() == std::hash<std::string_view>{}("api.example.com") && interned == std::string_view("api.example.com"));
+
+	std::cout << "... interned string test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting concurrent map test ... " << std::endl;
+
+	ConcurrentStringMap<char, int> map;
+	std::unordered_map<std::string, int> mapReference;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		std::string key = "key" + std::to_string(i);
+
+		map.Insert(key, i);
+		mapReference.emplace(key, i);
+	}
+
+	for (int i = 0; i < 1000; i += 3)
+	{
+		std::string key = "key" + std::to_string(i);
+
+		map.Erase(key);
+		mapReference.erase(key);
+	}
+
+	bool mapMatches = map.Size() == mapReference.size();
+
+	for (const auto& [key, value] : mapReference)
+		mapMatches = mapMatches && map.Find(key).value_or(-1) == value;
+
+	check("ConcurrentStringMap against std::unordered_map", mapMatches && !map.Contains("key0"));
+
+	AStr hashed = "hello";
+	bool hashesMatch = hashed.Hash() == std::hash<std::string_view>{}("hello");
+
+	hashed += " world";
+	hashesMatch = hashesMatch && hashed.Hash() == std::hash<std::string_view>{}("hello world");
+
+	hashed[0] = 'J';
+	hashesMatch = hashesMatch && hashed.Hash() == std::hash<std::string_view>{}("Jello world");
+
+	check("cached hash tracks edits", hashesMatch && map.Find(AStr("key1")).value_or(-1) == 1);
+
+	AStr iteratedHash = "hello";
+	size_t iteratedLetters = 0;
+
+	for (auto it = iteratedHash.begin(); it != iteratedHash.end(); ++it)
+		++iteratedLetters;
+
+	iteratedHash += " world";
+
+	check("hash cache after iteration and a locked write", iteratedLetters == 5 && iteratedHash.Hash() == std::hash<std::string_view>{}("hello world") && iteratedHash.Hash() == std::hash<std::string_view>{}("hello world"));
+
+	std::cout << "... concurrent map test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting pmr string test ... " << std::endl;
+
+	StringArena<> arena(std::pmr::null_memory_resource());
+
+	PmrAtomicString<char> pooled("a string long enough to leave the small buffer", arena.Resource());
+	std::string pooledReference = "a string long enough to leave the small buffer";
+
+	pooled += std::string(", plus a tail");
+	pooled.FindAndReplace(std::string("long"), std::string("LONG"));
+	pooledReference += ", plus a tail";
+	pooledReference.replace(pooledReference.find("long"), 4, "LONG");
+
+	PmrAtomicString<char> pooledCopy = pooled + "!";
+
+	check("pmr string edits", pooled == pooledReference && pooledCopy == pooledReference + "!");
+	check("pmr strings keep their resource", pooled.GetAllocator().resource() == arena.Resource() && pooledCopy.GetAllocator().resource() == arena.Resource());
+
+	PmrAtomicString<char> sharedPooled("a string allocated from the shared pool resource", StringResource::Shared());
+	sharedPooled += pooled;
+	check("shared pool resource", sharedPooled == "a string allocated from the shared pool resource" + pooledReference);
+
+	std::cout << "... pmr string test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting string builder test ... " << std::endl;
+
+	AtomicStringBuilder<char> builder(16);
+	std::vector<std::thread> producers;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		producers.emplace_back([&builder, i]
+		{
+			std::string record(7, char('a' + i));
+			record += '\n';
+
+			for (int k = 0; k < 2000; ++k)
+				builder.Append(record);
+		});
+	}
+
+	for (auto& producer : producers)
+		producer.join();
+
+	std::string built = builder.Seal();
+	bool recordsIntact = built.size() == 4 * 2000 * 8;
+	size_t recordCounts[4] = {};
+
+	for (size_t i = 0; recordsIntact && i < built.size(); i += 8)
+	{
+		recordsIntact = built.compare(i, 8, std::string(7, built[i]) + '\n') == 0 && built[i] >= 'a' && built[i] <= 'd';
+
+		if (recordsIntact)
+			++recordCounts[built[i] - 'a'];
+	}
+
+	check("concurrent appends stay whole", recordsIntact && std::count(std::begin(recordCounts), std::end(recordCounts), size_t(2000)) == 4);
+	check("sealed builder", builder.Sealed());
+
+	StringArena<128> builderArena(std::pmr::null_memory_resource());
+	AtomicStringBuilder<char, SharedMutexLockPolicy, std::pmr::polymorphic_allocator<char>> starved(16, builderArena.Resource());
+	bool appendFailed = false, sealFailed = false;
+
+	try
+	{
+		for (int k = 0; k < 32; ++k)
+			starved.Append("abcdefgh");
+	}
+	catch (const std::bad_alloc&)
+	{
+		appendFailed = true;
+	}
+
+	try
+	{
+		starved.Seal();
+	}
+	catch (const std::runtime_error&)
+	{
+		sealFailed = true;
+	}
+
+	check("failed append poisons Seal", appendFailed && sealFailed && starved.Sealed());
+
+	std::cout << "... string builder test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting compare-exchange test ... " << std::endl;
+
+	AStr exchanged = "01";
+	std::string expected = "zz";
+
+	bool rejected = !exchanged.CompareExchange(expected, "q") && expected == "01";
+	bool accepted = exchanged.CompareExchange(expected, "q") && exchanged == "q";
+
+	check("CompareExchange", rejected && accepted);
+
+	std::uint64_t seenVersion;
+	std::string seen = exchanged.Load(seenVersion);
+
+	bool applied = exchanged.UpdateIf(seenVersion, [](std::string& str) { str += "!"; });
+	bool stale = !exchanged.UpdateIf(seenVersion, [](std::string& str) { str += "?"; });
+
+	check("UpdateIf applies once per version", seen == "q" && applied && stale && exchanged == "q!");
+
+	AStr counter = "0";
+	std::vector<std::thread> incrementers;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		incrementers.emplace_back([&counter]
+		{
+			for (int k = 0; k < 500; ++k)
+			{
+				std::string current = "0";
+
+				while (!counter.CompareExchange(current, std::to_string(std::stoi(current) + 1)))
+					;
+			}
+		});
+	}
+
+	for (auto& incrementer : incrementers)
+		incrementer.join();
+
+	check("CompareExchange counter", counter == "2000");
+
+	std::uint64_t beforeIteration = exchanged.Version();
+	size_t iteratedChars = 0;
+
+	for (auto it = exchanged.begin(); it != exchanged.end(); ++it)
+		iteratedChars += exchanged[iteratedChars] == *it;
+
+	check("reading through iterators keeps the version", iteratedChars == 2 && exchanged.Version() == beforeIteration);
+
+	std::cout << "... compare-exchange test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting move-assign wake test ... " << std::endl;
+
+	AStr watched = "before";
+	std::uint64_t watchedVersion = watched.Version();
+	auto waitStart = std::chrono::steady_clock::now();
+
+	std::thread t9{ [&watched, watchedVersion] { watched.WaitForChange(watchedVersion, std::chrono::seconds(10)); } };
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	watched = AStr("after");
+	t9.join();
+
+	check("move-assign wakes waiter", std::chrono::steady_clock::now() - waitStart < std::chrono::seconds(5) && watched == "after");
+
+	std::cout << "... move-assign wake test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting subscription test ... " << std::endl;
+
+	AStr published = "start";
+	bool quietTimeout = !published.WaitForChange(published.Version(), std::chrono::milliseconds(20));
+
+	std::mutex latestMutex;
+	std::string latest;
+
+	{
+		auto subscription = published.Subscribe([&latestMutex, &latest](const std::string& value, std::uint64_t)
+		{
+			std::lock_guard<std::mutex> lock(latestMutex);
+			latest = value;
+		});
+
+		for (int i = 0; i < 50; ++i)
+			published = std::to_string(i);
+
+		for (int i = 0; i < 500; ++i)
+		{
+			{
+				std::lock_guard<std::mutex> lock(latestMutex);
+
+				if (latest == "49")
+					break;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+	}
+
+	check("WaitForChange times out without writes", quietTimeout);
+	check("Subscribe delivers the latest value", latest == "49");
+
+	std::cout << "... subscription test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting instrumentation test ... " << std::endl;
+
+#if defined(ATOMICBASE_INSTRUMENTATION)
+	AStr instrumented = "abc";
+	instrumented.Instrument();
+	instrumented.ToLower();
+	instrumented += "def";
+
+	auto lockSnapshot = instrumented.Statistics()->Take();
+	std::uint64_t toLowerAcquisitions = 0, appendAcquisitions = 0;
+
+	for (const auto& entry : lockSnapshot.entries)
+	{
+		if (entry.mode == LockMode::Exclusive && entry.operation == LockOperation::ToLower)
+			toLowerAcquisitions += entry.acquisitions;
+		else if (entry.mode == LockMode::Exclusive && entry.operation == LockOperation::Append)
+			appendAcquisitions += entry.acquisitions;
+	}
+
+	check("lock statistics attribute operations", toLowerAcquisitions == 1 && appendAcquisitions == 1);
+#else
+	std::cout << "  skipped: build with ATOMICBASE_INSTRUMENTATION to enable" << std::endl;
+#endif
+
+	std::cout << "... instrumentation test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting file I/O test ... " << std::endl;
+
+	std::filesystem::path ioPath = std::filesystem::temp_directory_path() / "atomicbase_run_tests.txt";
+	std::string ioContents;
+
+	for (int i = 0; i < 10000; ++i)
+		ioContents += "line " + std::to_string(i) + "\n";
+
+	{
+		std::ofstream output(ioPath, std::ios::binary);
+		output << ioContents;
+	}
+
+	AStr loaded;
+	size_t loadedBytes = loaded.LoadFromFile(ioPath);
+
+	check("LoadFromFile", loadedBytes == ioContents.length() && loaded == ioContents);
+
+	AStr appended = "header\n";
+
+	{
+		FileIO::Descriptor file(ioPath);
+		appended.AppendFromFd(file.Get());
+	}
+
+	check("AppendFromFd", appended == "header\n" + ioContents);
+
+	AStr limited;
+	AtomicString<char16_t> wide;
+	bool oddLimitRejected = false;
+
+	{
+		FileIO::Descriptor file(ioPath);
+		limited.AppendFromFd(file.Get(), 100);
+
+		try
+		{
+			wide.AppendFromFd(file.Get(), 3);
+		}
+		catch (const std::runtime_error&)
+		{
+			oddLimitRejected = true;
+		}
+
+		limited.AppendFromFd(file.Get());
+	}
+
+	check("AppendFromFd limits and resumes", oddLimitRejected && wide.Length() == 0 && limited == ioContents);
+
+	std::filesystem::remove(ioPath);
+
+	std::cout << "... file I/O test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting async lock policy test ... " << std::endl;
+
+	check("AsyncLockPolicy append", policy_append_matches<AsyncLockPolicy>());
+
+	AtomicString<char, AsyncLockPolicy> asyncStr;
+	std::atomic<size_t> asyncLength = 0;
+
+	std::thread t13{ [&asyncStr] { for (int k = 0; k < 2000; ++k) asyncStr += "a"; } };
+	async_append(asyncStr, asyncLength);
+	t13.join();
+
+	std::string asyncResult = asyncStr;
+
+	check("ModifyAsync under contention", asyncLength >= 2000 && asyncResult.length() == 4000 && std::count(asyncResult.begin(), asyncResult.end(), 'b') == 2000);
+
+	std::cout << "... async lock policy test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting compact lock policy test ... " << std::endl;
+
+	check("CompactLockPolicy append", policy_append_matches<CompactLockPolicy>());
+
+#if !defined(ATOMICBASE_INSTRUMENTATION)
+	if constexpr (sizeof(std::string) == 32)
+		check("CompactLockPolicy fits a cache line", sizeof(AtomicString<char, CompactLockPolicy>) <= 64);
+#endif
+
+	std::cout << "... compact lock policy test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting distributed lock policy test ... " << std::endl;
+
+	check("DistributedLockPolicy append", policy_append_matches<DistributedLockPolicy>());
+
+	AtomicString<char, DistributedLockPolicy> distributed = std::string(64, 'x');
+	std::atomic<bool> distributedTorn = false;
+
+	std::thread t14{ [&distributed] {
+		for (int k = 0; k < 2000; ++k)
+			distributed.Modify([k](std::string& s) { s.assign(64, k % 2 == 0 ? 'y' : 'x'); });
+	} };
+
+	std::thread t15{ [&distributed, &distributedTorn] {
+		for (int k = 0; k < 2000; ++k)
+			distributed.Read([&distributedTorn](const std::string& s) { if (s.find_first_not_of(s.front()) != std::string::npos) distributedTorn = true; });
+	} };
+
+	t14.join();
+	t15.join();
+
+	check("readers see whole writes", !distributedTorn);
+
+	std::cout << "... distributed lock policy test complete!" << std::endl;
+	std::cout << std::endl;
+
+
+	std::cout << "Starting journal replica test ... " << std::endl;
+
+	AStr journaled = "the quick brown fox";
+	journaled.EnableJournal();
+
+	std::uint64_t replicaVersion = 0;
+	std::string replica = journaled.Load(replicaVersion);
+	bool replicaMatches = true;
+	int deltaBatches = 0;
+
+	for (int i = 0; i < 200; ++i)
+	{
+		switch (i % 5)
+		{
+		case 0: journaled += " jumps"; break;
+		case 1: journaled.FindAndReplace("jumps", "leaps"); break;
+		case 2: journaled -= "leaps"; break;
+		case 3: journaled += std::string(3, char('a' + i % 26)); break;
+		default: if (i % 50 == 4) journaled.Clear(); else journaled += "!"; break;
+		}
+
+		auto batch = journaled.Changes(replicaVersion);
+
+		if (!batch.snapshot)
+			++deltaBatches;
+
+		replicaVersion = AStr::journal_type::Apply(replica, batch);
+		replicaMatches = replicaMatches && replica == std::string(journaled);
+	}
+
+	check("journal replay into replica", replicaMatches && deltaBatches == 200);
+
+	AStr touched = "hello world";
+	touched.EnableJournal();
+
+	std::uint64_t touchedVersion = 0;
+	std::string touchedReplica = touched.Load(touchedVersion);
+
+	*touched.begin() = 'J';
+	touched[1] = 'E';
+	touched += "!";
+
+	auto touchedBatch = touched.Changes(touchedVersion);
+	touchedVersion = AStr::journal_type::Apply(touchedReplica, touchedBatch);
+
+	touched += "?";
+	touchedVersion = AStr::journal_type::Apply(touchedReplica, touched.Changes(touchedVersion));
+
+	check("writes through references reach the replica", touchedBatch.snapshot && touchedReplica == "JEllo world!?" && touched == "JEllo world!?");
+
+	AStr unjournaled = "lazy dog";
+	unjournaled.EnableJournal();
+
+	std::string unjournaledReplica = unjournaled.Load(replicaVersion);
+	bool unrecordedMatch = true;
+	int snapshotBatches = 0;
+
+	for (int i = 0; i < 120; ++i)
+	{
+		switch (i % 12)
+		{
+		case 0: unjournaled.Modify([](std::string& str) { str.insert(0, "the "); }); break;
+		case 2: unjournaled = std::string("a lazy dog"); break;
+		case 4: unjournaled.ToUpper(); break;
+		case 6: unjournaled.UpdateIf(unjournaled.Version(), [](std::string& str) { str[0] = 'z'; }); break;
+		case 8: unjournaled.Write()[1] = 'y'; break;
+		case 10: unjournaled.ModifyEachChunk([](std::span<char> chunk) { chunk[0] = 'x'; }, 4); break;
+		default: unjournaled += " sleeps"; break;
+		}
+
+		auto batch = unjournaled.Changes(replicaVersion);
+
+		if (batch.snapshot)
+			++snapshotBatches;
+
+		replicaVersion = AStr::journal_type::Apply(unjournaledReplica, batch);
+		unrecordedMatch = unrecordedMatch && unjournaledReplica == std::string(unjournaled);
+	}
+
+	check("unrecorded writes fall back to snapshots", unrecordedMatch && snapshotBatches == 60);
+
+	std::cout << "... journal replica test complete!" << std::endl;
+
+	return mismatches == 0 ? 0 : 1;
 }
\ No newline at end of file